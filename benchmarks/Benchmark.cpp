@@ -0,0 +1,463 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "ATSP.h"
+#include "Timer.h"
+
+using namespace std;
+
+// Testy wydajności algorytmu genetycznego:
+//  - mikrotesty operatorów (koszt trasy, krzyżowanie OX/PMX, mutacja, selekcja, sortowanie, sukcesja)
+//    na losowych macierzach dla różnych V i wielkości populacji,
+//  - czas do osiągnięcia celu (time-to-target) na instancjach TSPLIB o znanych kosztach optymalnych.
+// Wyniki można zapisać (--save) i porównać z zapisanym wcześniej punktem odniesienia (--baseline).
+class Benchmark {
+public:
+    static int run(int argc, char* argv[]);
+
+private:
+    // Wyniki: nazwa pomiaru -> wartość (ns na operację lub sekundy do celu)
+    using Results = map<string, double>;
+
+    // Minimalny czas jednej serii pomiarowej [s], liczba serii pomiaru i domyślna liczba przebiegów
+    // wszystkich mikrotestów
+    static constexpr double MeasureTime = 0.02;
+    static constexpr int Repetitions = 3;
+    static constexpr int DefaultRounds = 5;
+
+    static void syntheticInstance(ATSP& atsp, int V, uint64_t seed);
+
+    static void randomTour(int* tour, int V, Random& random);
+
+    // Pomiar czasu operacji [ns] - minimum z Repetitions serii o tej samej liczbie wywołań (dobranej
+    // tak, aby seria trwała co najmniej MeasureTime)
+    template<typename Operation>
+    static double measure(Operation&& operation);
+
+    // Mikrotesty wykonywane rounds razy - wynikiem jest mediana z przebiegów. Próbki jednego testu
+    // są rozłożone w czasie, więc zakłócenia trwające dłużej niż pojedynczy pomiar (inne procesy,
+    // zmiany częstotliwości procesora) nie trafiają do wyniku jako spowolnienie ani przyspieszenie
+    static void microBenchmarks(Results& results, int rounds);
+
+    static void microRound(Results& results, vector<string>& names);
+
+    static void timeToTarget(const string& directory, int runs, double timeLimit, double gap,
+                             const string& method, Results& results);
+
+    static bool loadResults(const string& fileName, Results& results);
+
+    static void saveResults(const string& fileName, const Results& results);
+};
+
+// Zapobiega usunięciu przez kompilator obliczeń, których wynik nie jest używany
+static volatile long long sink;
+
+void Benchmark::syntheticInstance(ATSP& atsp, int V, uint64_t seed) {
+    Random random(seed);
+    atsp.initializeDistanceMatrix(V);
+    DistanceMatrix& matrix = atsp.distanceProvider.useMatrix();
+    for (int i = 0; i < V; i++) {
+        for (int j = 0; j < V; j++) {
+            matrix.cell(i, j) = i == j ? -1 : random.nextInt(1, 1000);
+        }
+    }
+}
+
+void Benchmark::randomTour(int* tour, int V, Random& random) {
+    iota(tour, tour + V, 0);
+    for (int i = V - 1; i > 0; i--) {
+        swap(tour[i], tour[random.nextInt(0, i)]);
+    }
+}
+
+template<typename Operation>
+double Benchmark::measure(Operation&& operation) {
+    // Rozgrzewka (pamięć podręczna, predyktor skoków)
+    for (int i = 0; i < 100; i++) {
+        operation();
+    }
+
+    // Dobór liczby wywołań w serii (pierwsza seria, która trwała co najmniej MeasureTime)
+    long long iterations = 64;
+    double best;
+    while (true) {
+        Timer timer;
+        for (long long i = 0; i < iterations; i++) {
+            operation();
+        }
+        const double elapsed = timer.elapsedSeconds();
+        if (elapsed >= MeasureTime) {
+            best = elapsed * 1e9 / iterations;
+            break;
+        }
+        iterations *= 2;
+    }
+
+    for (int repetition = 1; repetition < Repetitions; repetition++) {
+        Timer timer;
+        for (long long i = 0; i < iterations; i++) {
+            operation();
+        }
+        best = min(best, timer.elapsedSeconds() * 1e9 / iterations);
+    }
+    return best;
+}
+
+void Benchmark::microBenchmarks(Results& results, int rounds) {
+    vector<string> names;
+    map<string, vector<double>> samples;
+    for (int round = 0; round < rounds; round++) {
+        cerr << "Mikrotesty: przebieg " << round + 1 << "/" << rounds << endl;
+        Results roundResults;
+        microRound(roundResults, names);
+        for (const auto& result : roundResults) {
+            samples[result.first].push_back(result.second);
+        }
+    }
+
+    cout << "--- Mikrotesty operatorow [ns/operacja, mediana z " << rounds << " przebiegow] ---" << endl;
+    for (const string& name : names) {
+        vector<double>& values = samples[name];
+        sort(values.begin(), values.end());
+        results[name] = values[values.size() / 2];
+        cout << left << setw(36) << name << right << fixed << setprecision(1) << setw(14) << results[name] << endl;
+    }
+    cout << defaultfloat << setprecision(6);
+}
+
+void Benchmark::microRound(Results& results, vector<string>& names) {
+    const vector<int> dimensions = {17, 48, 100, 171, 443, 1000};
+    const vector<int> populationSizes = {50, 200, 1000};
+
+    auto report = [&results, &names](const string& name, double nanoseconds) {
+        if (find(names.begin(), names.end(), name) == names.end()) {
+            names.push_back(name);
+        }
+        results[name] = nanoseconds;
+    };
+
+    for (int V : dimensions) {
+        ATSP atsp;
+        syntheticInstance(atsp, V, 12345);
+        Random random(V);
+
+        vector<int> parent1(V), parent2(V), child1(V), child2(V);
+        randomTour(parent1.data(), V, random);
+        randomTour(parent2.data(), V, random);
+        CrossoverScratch scratch;
+        scratch.resize(V);
+
+        report("calculateCost V=" + to_string(V), measure([&]() {
+            sink = sink + atsp.calculateCost(parent1.data());
+        }));
+
+        // Reprezentacja zwarta - geny uint16_t i odległości int16_t
+        DistanceMatrix compactMatrix = atsp.distanceProvider.matrix();
+        compactMatrix.narrow();
+        const DistanceView<int16_t> compactDistances = compactMatrix.view<int16_t>();
+        vector<uint16_t> compactTour(parent1.begin(), parent1.end());
+        report("calculateCost16 V=" + to_string(V), measure([&]() {
+            sink = sink + atsp.costEvaluator.cost(compactDistances, compactTour.data());
+        }));
+
+        // Odległości liczone na bieżąco ze współrzędnych (EUC_2D) zamiast odczytu z macierzy
+        vector<double> x(V), y(V);
+        for (int i = 0; i < V; i++) {
+            x[i] = random.nextDouble() * 10000.0;
+            y[i] = random.nextDouble() * 10000.0;
+        }
+        const CoordinateDistances coordinates{x.data(), y.data(), V, CoordinateMetric::Euclidean};
+        report("calculateCostCoord V=" + to_string(V), measure([&]() {
+            sink = sink + atsp.costEvaluator.cost(coordinates, parent1.data());
+        }));
+
+        // Pełne obliczenie skrótu trasy (eliminacja duplikatów i pamięć kosztów)
+        TourHash tourHash;
+        tourHash.prepare(V);
+        report("tourHash V=" + to_string(V), measure([&]() {
+            sink = sink + static_cast<int>(tourHash.hash(parent1.data()));
+        }));
+
+        report("crossoverOX V=" + to_string(V), measure([&]() {
+            atsp.crossoverOX(parent1.data(), parent2.data(), child1.data(), scratch, random);
+        }));
+
+        // Jedno wywołanie PMX tworzy oba potomki
+        report("crossoverPMX V=" + to_string(V), measure([&]() {
+            atsp.crossoverPMX(parent1.data(), parent2.data(), child1.data(), child2.data(), scratch, random);
+        }));
+
+        PopulationArena arena;
+        arena.allocate(1, V);
+        const int slot = arena.currentSlot(0);
+        arena.writeGenes(slot, parent1.data());
+        arena.cost(slot) = atsp.calculateCost(parent1.data());
+        arena.setDirty(slot, false);
+        report("insertionMutation V=" + to_string(V), measure([&]() {
+            atsp.insertionMutation(arena, slot, random);
+        }));
+
+        report("swapMutation V=" + to_string(V), measure([&]() {
+            atsp.swapMutation(arena, slot, random);
+        }));
+    }
+
+    for (int N : populationSizes) {
+        const int V = 100;
+        Random random(N);
+
+        vector<int> costs(N);
+        for (int& cost : costs) {
+            cost = random.nextInt(1000, 100000);
+        }
+
+        // Selekcja całej puli rodziców (przygotowanie + N losowań) dla każdej metody
+        Selection selection;
+        for (const string method : {"RW", "BS", "ALIAS", "TOUR"}) {
+            const string name = method == "RW" ? "rouletteWheel" : "selection " + method;
+            report(name + " N=" + to_string(N), measure([&]() {
+                selection.prepare(costs.data(), N, method, 3);
+                long long sum = 0;
+                for (int i = 0; i < N; i++) {
+                    sum += selection.select(random);
+                }
+                sink = sink + sum;
+            }));
+        }
+
+        // Pełne sortowanie rodziców i potomstwa według kosztu (punkt odniesienia dla sukcesji)
+        vector<int> order(2 * N);
+        vector<int> allCosts(2 * N);
+        for (int& cost : allCosts) {
+            cost = random.nextInt(1000, 100000);
+        }
+        report("sortByCost N=" + to_string(N), measure([&]() {
+            iota(order.begin(), order.end(), 0);
+            sort(order.begin(), order.end(), [&allCosts](int a, int b) {
+                return allCosts[a] < allCosts[b];
+            });
+            sink = sink + order[0];
+        }));
+
+        // Sukcesja na arenie z losowymi kosztami
+        PopulationArena arena;
+        arena.allocate(N, V);
+        for (int i = 0; i < N; i++) {
+            arena.cost(arena.currentSlot(i)) = allCosts[i];
+            arena.cost(arena.offspringSlot(i)) = allCosts[N + i];
+            arena.setDirty(arena.currentSlot(i), false);
+            arena.setDirty(arena.offspringSlot(i), false);
+        }
+        vector<int> parents(N);
+        for (int& parent : parents) {
+            parent = random.nextInt(0, N - 1);
+        }
+        Succession succession;
+        succession.prepare(N);
+        for (const string policy : {"PARENTS", "PLUS", "COMMA", "STEADY"}) {
+            report("succession " + policy + " N=" + to_string(N), measure([&]() {
+                succession.apply(arena, parents, policy, max(1, N / 10));
+            }));
+        }
+    }
+}
+
+void Benchmark::timeToTarget(const string& directory, int runs, double timeLimit, double gap,
+                             const string& method, Results& results) {
+    // Koszty optymalne instancji ATSP z biblioteki TSPLIB
+    const vector<pair<string, int>> optima = {
+            {"br17",   39},
+            {"ftv33",  1286},
+            {"ftv35",  1473},
+            {"ftv38",  1530},
+            {"p43",    5620},
+            {"ftv44",  1613},
+            {"ftv47",  1776},
+            {"ry48p",  14422},
+            {"ft53",   6905},
+            {"ftv55",  1608},
+            {"ftv64",  1839},
+            {"ft70",   38673},
+            {"ftv70",  1950},
+            {"ftv90",  1579},
+            {"ftv100", 1788},
+            {"ftv110", 1958},
+            {"ftv120", 2166},
+            {"kro124p", 36230},
+            {"ftv130", 2307},
+            {"ftv140", 2420},
+            {"ftv150", 2611},
+            {"ftv160", 2683},
+            {"ftv170", 2755},
+            {"rbg323", 1326},
+            {"rbg358", 1163},
+            {"rbg403", 2465},
+            {"rbg443", 2720}
+    };
+
+    cout << "--- Czas do osiagniecia celu (optimum + " << gap * 100 << "%, " << runs << " przebiegow, limit "
+         << timeLimit << "s, " << method << ") ---" << endl;
+    cout << left << setw(10) << "instancja" << right << setw(10) << "optimum" << setw(10) << "cel"
+         << setw(10) << "sukces" << setw(14) << "mediana [s]" << setw(14) << "najlepszy" << endl;
+
+    for (const auto& instance : optima) {
+        const string fileName = (filesystem::path(directory) / (instance.first + ".atsp")).string();
+        if (!filesystem::exists(fileName)) {
+            continue;
+        }
+
+        ATSP atsp;
+        if (!atsp.loadATSPFile(fileName)) {
+            cerr << "ERROR while loading the file: " << atsp.loadError() << endl;
+            continue;
+        }
+
+        const long long target = static_cast<long long>(instance.second * (1.0 + gap));
+        vector<double> times;
+        int successes = 0;
+        int bestCost = numeric_limits<int>::max();
+
+        for (int run = 0; run < runs; run++) {
+            GAParameters parameters = ATSP::parseParameters(method, to_string(timeLimit), "100", "0.8", "0.05",
+                                                            to_string(run + 1), "1", "", "", "", "", "", "",
+                                                            "", "", "", "", "", "", "");
+            parameters.targetCost = target;
+
+            GAResult result = atsp.solve(parameters);
+            bestCost = min(bestCost, result.bestCost);
+            if (result.targetReached) {
+                successes++;
+                times.push_back(result.executionTime);
+            } else {
+                // Nieudany przebieg liczony jest jako pełny limit czasu
+                times.push_back(timeLimit);
+            }
+        }
+
+        sort(times.begin(), times.end());
+        const double median = times[times.size() / 2];
+        results["timeToTarget " + instance.first] = median;
+
+        cout << left << setw(10) << instance.first << right << setw(10) << instance.second << setw(10) << target
+             << setw(7) << successes << "/" << setw(2) << runs << setw(14) << fixed << setprecision(3) << median
+             << setw(14) << bestCost << endl;
+        cout << defaultfloat << setprecision(6);
+    }
+}
+
+bool Benchmark::loadResults(const string& fileName, Results& results) {
+    ifstream file(fileName);
+    if (!file.is_open()) {
+        return false;
+    }
+    string line;
+    while (getline(file, line)) {
+        const size_t separator = line.rfind(',');
+        if (separator != string::npos) {
+            results[line.substr(0, separator)] = stod(line.substr(separator + 1));
+        }
+    }
+    return true;
+}
+
+void Benchmark::saveResults(const string& fileName, const Results& results) {
+    ofstream file(fileName, ios::out | ios::trunc);
+    file << setprecision(10);
+    for (const auto& result : results) {
+        file << result.first << "," << result.second << "\n";
+    }
+}
+
+int Benchmark::run(int argc, char* argv[]) {
+    bool micro = false;
+    string instanceDirectory;
+    string saveFile;
+    string baselineFile;
+    int rounds = DefaultRounds;
+    string method = "OX";
+    int runs = 5;
+    double timeLimit = 60.0;
+    double gap = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        const string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (argument == "--micro") {
+            micro = true;
+        } else if (argument == "--ttt" && hasValue) {
+            instanceDirectory = argv[++i];
+        } else if (argument == "--runs" && hasValue) {
+            runs = max(1, stoi(argv[++i]));
+        } else if (argument == "--time" && hasValue) {
+            timeLimit = stod(argv[++i]);
+        } else if (argument == "--gap" && hasValue) {
+            gap = stod(argv[++i]) / 100.0;
+        } else if (argument == "--method" && hasValue) {
+            method = argv[++i];
+        } else if (argument == "--save" && hasValue) {
+            saveFile = argv[++i];
+        } else if (argument == "--baseline" && hasValue) {
+            baselineFile = argv[++i];
+        } else if (argument == "--rounds" && hasValue) {
+            rounds = max(1, stoi(argv[++i]));
+        } else {
+            cout << "Uzycie: benchmark [--micro] [--ttt katalog_tsplib] [--runs n] [--time s] [--gap %]\n"
+                    "                 [--method OX|PMX] [--rounds n] [--save plik.csv] [--baseline plik.csv]\n";
+            return 2;
+        }
+    }
+
+    // Bez wskazania części wykonywane są mikrotesty
+    if (!micro && instanceDirectory.empty()) {
+        micro = true;
+    }
+
+    Results results;
+    if (micro) {
+        microBenchmarks(results, rounds);
+    }
+    if (!instanceDirectory.empty()) {
+        timeToTarget(instanceDirectory, runs, timeLimit, gap, method, results);
+    }
+
+    if (!saveFile.empty()) {
+        saveResults(saveFile, results);
+    }
+
+    // Porównanie z punktem odniesienia (stosunek > 1 oznacza spowolnienie)
+    if (!baselineFile.empty()) {
+        Results baseline;
+        if (!loadResults(baselineFile, baseline)) {
+            cerr << "ERROR while opening the baseline file: " << baselineFile << endl;
+            return 1;
+        }
+        cout << "--- Porownanie z punktem odniesienia " << baselineFile << " ---" << endl;
+        int regressions = 0;
+        for (const auto& result : results) {
+            auto reference = baseline.find(result.first);
+            if (reference == baseline.end() || reference->second <= 0.0) {
+                continue;
+            }
+            const double ratio = result.second / reference->second;
+            const bool regression = ratio > 1.10;
+            regressions += regression;
+            cout << left << setw(36) << result.first << right << fixed << setprecision(2) << setw(8) << ratio << "x"
+                 << (regression ? "  SPOWOLNIENIE" : "") << endl;
+        }
+        cout << defaultfloat << setprecision(6);
+        return regressions > 0 ? 1 : 0;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    return Benchmark::run(argc, argv);
+}
@@ -1,11 +1,29 @@
-#include <windows.h>
-#include <fstream>
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
-#include <random>
-#include <unordered_map>
+#include <thread>
+#include <memory>
+#include <atomic>
+#include <type_traits>
+#include <utility>
 
 #include "ATSP.h"
+#include "ThreadPool.h"
+#include "AllocationCounter.h"
+#include "TSPLIBLoader.h"
+#include "InstanceCache.h"
+#include "Checkpoint.h"
+#include "Timer.h"
+#include "ConvergenceTrace.h"
+#include "TourBuilder.h"
+#include "LowerBound.h"
+#include "NumberParsing.h"
+
+namespace {
+
+    // Największe względne zaburzenie kosztów łuków w kolejnych trasach heurystyki GREEDY
+    const double SeedingNoise = 0.1;
+}
 
 // Funkcja inicjalizująca macierz odległości
 void ATSP::initializeDistanceMatrix(const int& newDimension) {
@@ -13,7 +31,7 @@ void ATSP::initializeDistanceMatrix(const int& newDimension) {
     V = newDimension;
 
     // Inicjalizacja macierzy o odpowiednich wymiarach
-    distanceMatrix = vector<vector<int>>(V, vector<int>(V));
+    distanceProvider.useMatrix().resize(V);
 }
 
 // Funkcja pomocnicza służąca do czyszczenia macierzy
@@ -22,10 +40,7 @@ void ATSP::clearDistanceMatrix() {
     V = 0;
 
     // Czyszczenie macierzy odległości
-    for (auto& innerVector : distanceMatrix) {
-        innerVector.clear();
-    }
-    distanceMatrix.clear();
+    distanceProvider.clear();
 }
 
 // Funkcja wyświetlająca zawartość macierzy odległości
@@ -35,426 +50,1246 @@ void ATSP::printDistanceMatrix() {
     int fieldWidth = 4;
 
     // Pętle iterujące po każdym elemencie macierzy
-    for (const auto& row: distanceMatrix) {
-        for (const auto& distance: row) {
-            cout << setw(fieldWidth) << distance;
+    for (int i = 0; i < distanceProvider.dimension(); i++) {
+        for (int j = 0; j < distanceProvider.dimension(); j++) {
+            cout << setw(fieldWidth) << distanceProvider(i, j);
         }
         cout << endl;
     }
 }
 
-// Funkcja służąca do wczytywania pliku ATSP do tablicy dwuwymiarowej
-void ATSP::loadATSPFile(const string& fileName) {
+// Funkcja służąca do wczytywania pliku TSPLIB (ATSP/TSP) do macierzy odległości.
+// Przy pierwszym wczytaniu zapisywana jest binarna kopia instancji, którą kolejne wczytania
+// odwzorowują w pamięci bez parsowania. Można też podać bezpośrednio plik z binarną kopią.
+// Instancje, których pełna macierz nie mieści się w limicie pamięci (lub inna postać wybrana
+// w options), przechowywane są jako współrzędne albo rzadki zbiór łuków - bez kopii binarnej.
+bool ATSP::loadATSPFile(const string& fileName, const DistanceOptions& options) {
+    instanceError.clear();
 
-    //Otwórz plik do odczytu
-    ifstream file;
-    file.open(fileName, ifstream::in);
+    // Zakres kosztów sprawdzany po każdym wczytaniu (także kopii binarnej, która mogła zostać zmieniona)
+    return readInstanceFile(fileName, options) && checkTourCostRange();
+}
 
-    if (file.is_open()) {
-        string line;
+// Wczytanie odległości z pliku TSPLIB, jego kopii binarnej albo podanego pliku binarnego
+bool ATSP::readInstanceFile(const string& fileName, const DistanceOptions& options) {
+    string error;
 
-        // Pętla iterująca po każdym wierszu tekstu w pliku
-        while (getline(file, line)) {
+    if (InstanceCache::isCacheFile(fileName)) {
+        DistanceMatrix& matrix = distanceProvider.useMatrix();
+        if (InstanceCache::load(fileName, "", matrix)) {
+            V = matrix.dimension();
+            matrix.narrow();
+            return true;
+        }
+        instanceError = "invalid binary instance";
+        clearDistanceMatrix();
+        return false;
+    }
 
-            // Sprawdzenie, czy w obecnej linii znajduje się informacja o rozmiarze grafu
-            if (line.find("DIMENSION: ") != string::npos) {
-                size_t pos = line.find(": ");
+    const string cacheFileName = InstanceCache::cacheFileName(fileName);
+    const bool denseAllowed = options.storage == DistanceProvider::Storage::Auto ||
+                              options.storage == DistanceProvider::Storage::Dense;
+    if (denseAllowed) {
+        DistanceMatrix& matrix = distanceProvider.useMatrix();
+        if (InstanceCache::load(cacheFileName, fileName, matrix) &&
+            (options.storage == DistanceProvider::Storage::Dense || options.denseFits(matrix.dimension()))) {
+            V = matrix.dimension();
+
+            // Kopia z elementami 32-bitowymi, które mieszczą się w 16 bitach, jest zapisywana ponownie
+            if (matrix.elementWidth() != sizeof(int16_t) && matrix.narrow()) {
+                InstanceCache::save(cacheFileName, fileName, matrix);
+            }
+            return true;
+        }
+    }
 
-                // Inicjalizacja macierzy odległości na podstawie rozmiaru
-                initializeDistanceMatrix(stoi(line.substr(pos + 1)));
+    if (TSPLIBLoader::load(fileName, distanceProvider, options, error)) {
+        V = distanceProvider.dimension();
 
-                // Rozpoczęcie procesu wczytywania odległości do macierzy
-            } else if (line.find("EDGE_WEIGHT_SECTION") != string::npos) {
-                for (int i = 0; i < V; i++) {
-                    for (int j = 0; j < V; j++) {
-                        file >> distanceMatrix[i][j];
-                        if (i == j) {
-                            // Ustawianie -1 na głównej przekątnej
-                            distanceMatrix[i][j] = -1;
-                        }
-                    }
-                }
-            }
+        if (distanceProvider.storage() == DistanceProvider::Storage::Dense) {
+            // Najwęższy typ elementów mieszczący wszystkie odległości (zapisywany także w kopii binarnej)
+            DistanceMatrix& matrix = distanceProvider.useMatrix();
+            matrix.narrow();
+
+            // Błąd zapisu kopii (np. katalog tylko do odczytu) nie wpływa na wczytaną instancję
+            InstanceCache::save(cacheFileName, fileName, matrix);
         }
-    } else {
-        // Komunikat o błędzie w przypadku problemu z otwarciem pliku
-        cerr << "ERROR while opening the file." << endl;
+        return true;
     }
-    file.close();
+
+    // Opis błędu w przypadku problemu z otwarciem lub parsowaniem pliku
+    instanceError = error;
+    clearDistanceMatrix();
+    return false;
+}
+
+// Instancja przekazana z pamięci przez kod osadzający algorytm: pełna macierz V x V w porządku
+// wierszowym (elementy przekątnej są pomijane), zawężana jak macierz wczytana z pliku
+bool ATSP::loadMatrix(int newDimension, const vector<int>& distances) {
+    instanceError.clear();
+    if (newDimension < 2 || distances.size() != static_cast<size_t>(newDimension) * newDimension) {
+        instanceError = "expected " + to_string(newDimension) + " x " + to_string(newDimension) + " distances";
+        clearDistanceMatrix();
+        return false;
+    }
+
+    initializeDistanceMatrix(newDimension);
+    DistanceMatrix& matrix = distanceProvider.useMatrix();
+    for (int i = 0; i < V; i++) {
+        for (int j = 0; j < V; j++) {
+            matrix.cell(i, j) = i == j ? -1 : distances[static_cast<size_t>(i) * V + j];
+        }
+    }
+    return acceptLoadedInstance();
+}
+
+// Instancja euklidesowa lub geograficzna podana współrzędnymi miast (bez pełnej macierzy)
+bool ATSP::loadCoordinates(vector<double> x, vector<double> y, CoordinateMetric metric) {
+    instanceError.clear();
+    if (x.size() < 2 || x.size() != y.size()) {
+        instanceError = "invalid number of cities";
+        clearDistanceMatrix();
+        return false;
+    }
+
+    V = static_cast<int>(x.size());
+    distanceProvider.useCoordinates(V, move(x), move(y), metric);
+    return acceptLoadedInstance();
 }
 
-// Metoda do uruchamiania algorytmu genetycznego dla problemu ATSP
-void ATSP::geneticAlgorithm(const string& fileName,
-                            const string& crossingMethod,
+// Koszt trasy sumowany jest w typie int - instancja, w której mógłby się przepełnić, jest odrzucana
+bool ATSP::checkTourCostRange() {
+    if (distanceProvider.tourCostBound() > numeric_limits<int>::max()) {
+        instanceError = "tour costs exceed the 32-bit range";
+        clearDistanceMatrix();
+        return false;
+    }
+    return true;
+}
+
+// Sprawdzenie zakresu kosztów tras i zawężenie macierzy instancji przekazanej z pamięci
+bool ATSP::acceptLoadedInstance() {
+    if (!checkTourCostRange()) {
+        return false;
+    }
+    if (distanceProvider.storage() == DistanceProvider::Storage::Dense) {
+        distanceProvider.useMatrix().narrow();
+    }
+    return true;
+}
+
+// Metoda do uruchamiania algorytmu genetycznego dla problemu ATSP (parametry w postaci tekstowej)
+void ATSP::geneticAlgorithm(const string& crossingMethod,
                             const string& maxExecutionTimeFactor,
                             const string& populationSizeFactor,
                             const string& crossoverRateFactor,
-                            const string& mutationRateFactor) {
+                            const string& mutationRateFactor,
+                            const string& seedFactor,
+                            const string& threadCountFactor,
+                            const string& islandCountFactor,
+                            const string& migrationIntervalFactor,
+                            const string& migrantCountFactor,
+                            const string& migrationTopology,
+                            const string& selectionMethod,
+                            const string& tournamentSizeFactor,
+                            const string& successionPolicy,
+                            const string& replacementCountFactor,
+                            const string& localSearchMode,
+                            const string& checkpointFile,
+                            const string& checkpointIntervalFactor,
+                            const string& traceFile,
+                            const string& traceIntervalFactor) {
+
+    // Wartość, która nie jest liczbą (np. "10x"), kończy obliczenia komunikatem, a nie przerwaniem programu
+    GAParameters parameters;
+    try {
+        parameters = parseParameters(crossingMethod, maxExecutionTimeFactor, populationSizeFactor,
+                                     crossoverRateFactor, mutationRateFactor, seedFactor, threadCountFactor,
+                                     islandCountFactor, migrationIntervalFactor, migrantCountFactor,
+                                     migrationTopology, selectionMethod, tournamentSizeFactor,
+                                     successionPolicy, replacementCountFactor, localSearchMode,
+                                     checkpointFile, checkpointIntervalFactor, traceFile, traceIntervalFactor);
+    } catch (const exception&) {
+        cerr << "ERROR: invalid numeric parameter value" << endl;
+        return;
+    }
+
+    string error;
+    if (!checkParameters(parameters, error)) {
+        cerr << "ERROR: " << error << endl;
+        return;
+    }
+
+    GAResult result = solve(parameters);
+    for (const string& warning : result.warnings) {
+        cerr << "ERROR: " << warning << endl;
+    }
+    printResult(parameters, result);
+}
 
-    // Pomiar częstotliwości zegara
-    long long int frequency, startTime, endTime;
-    QueryPerformanceFrequency((LARGE_INTEGER *) &frequency);
+// Metoda zamieniająca parametry w postaci tekstowej na parametry algorytmu
+// (puste wartości parametrów opcjonalnych oznaczają wartości domyślne). Wartości liczbowe muszą być
+// w całości liczbami - w przeciwnym razie zgłaszany jest wyjątek (NumberParsing.h)
+GAParameters ATSP::parseParameters(const string& crossingMethod,
+                                   const string& maxExecutionTimeFactor,
+                                   const string& populationSizeFactor,
+                                   const string& crossoverRateFactor,
+                                   const string& mutationRateFactor,
+                                   const string& seedFactor,
+                                   const string& threadCountFactor,
+                                   const string& islandCountFactor,
+                                   const string& migrationIntervalFactor,
+                                   const string& migrantCountFactor,
+                                   const string& migrationTopology,
+                                   const string& selectionMethod,
+                                   const string& tournamentSizeFactor,
+                                   const string& successionPolicy,
+                                   const string& replacementCountFactor,
+                                   const string& localSearchMode,
+                                   const string& checkpointFile,
+                                   const string& checkpointIntervalFactor,
+                                   const string& traceFile,
+                                   const string& traceIntervalFactor) {
 
     // Konwersja parametrów wejściowych na odpowiednie typy
-    const double maxExecutionTime = stod(maxExecutionTimeFactor);
-    const int populationSize = stoi(populationSizeFactor);
-    const double crossoverRate = stod(crossoverRateFactor);
-    const double mutationRate = stod(mutationRateFactor);
+    GAParameters parameters;
+    parameters.crossingMethod = crossingMethod;
+    parameters.maxExecutionTime = parseDouble(maxExecutionTimeFactor);
+    parameters.populationSize = parseInt(populationSizeFactor);
+    parameters.crossoverRate = parseDouble(crossoverRateFactor);
+    parameters.mutationRate = parseDouble(mutationRateFactor);
+
+    // Ziarno generatora liczb pseudolosowych (brak ziarna oznacza przebieg niepowtarzalny)
+    parameters.seed = seedFactor.empty() ? Random::randomSeed() : parseUnsigned(seedFactor);
+
+    // Liczba wątków (brak wartości - tryb jednowątkowy, 0 - wszystkie wątki sprzętowe)
+    parameters.threadCount = threadCountFactor.empty() ? 1 : parseInt(threadCountFactor);
+    if (parameters.threadCount <= 0) {
+        parameters.threadCount = ThreadPool::hardwareThreads();
+    }
+
+    // Parametry modelu wyspowego (brak wartości - jedna populacja)
+    parameters.islandCount = islandCountFactor.empty() ? 1 : max(1, parseInt(islandCountFactor));
+    parameters.migrationInterval = migrationIntervalFactor.empty() ? 50 : max(1, parseInt(migrationIntervalFactor));
+    parameters.migrantCount = migrantCountFactor.empty() ? 2 : max(0, parseInt(migrantCountFactor));
+    parameters.migrationTopology = migrationTopology.empty() ? "RING" : migrationTopology;
+
+    // Metoda selekcji rodziców (domyślnie koło ruletki)
+    parameters.selectionMethod = selectionMethod.empty() ? "RW" : selectionMethod;
+    parameters.tournamentSize = tournamentSizeFactor.empty() ? 2 : max(1, parseInt(tournamentSizeFactor));
 
-    // Aktualna populacja chromosomów
-    vector<vector<int>> currentPopulation;
+    // Strategia sukcesji (domyślnie najlepsze spośród rodziców i potomstwa)
+    parameters.successionPolicy = successionPolicy.empty() ? "PARENTS" : successionPolicy;
+    parameters.replacementCount = replacementCountFactor.empty() ? max(1, parameters.populationSize / 10)
+                                                                 : max(1, parseInt(replacementCountFactor));
 
-    // Wartości przystosowania dla każdego chromosomu w populacji
-    vector<double> fitnessValues;
+    // Przeszukiwanie lokalne potomstwa (OFF, BEST, ALL)
+    parameters.localSearchMode = localSearchMode.empty() ? "OFF" : localSearchMode;
 
-    // Inicjalizacja wektora przechowującego prawdopodobieństwa
-    vector<double> probabilities;
+    // Punkt kontrolny (co checkpointInterval pokoleń oraz po zakończeniu obliczeń)
+    parameters.checkpointFile = checkpointFile;
+    parameters.checkpointInterval = checkpointIntervalFactor.empty() ? 1000 : max(1, parseInt(checkpointIntervalFactor));
 
-    // Inicjalizacja wektora wektorów przechowującego rodziców
-    vector<vector<int>> parents;
+    // Przebieg zbieżności (co traceInterval pokoleń)
+    parameters.traceFile = traceFile;
+    parameters.traceInterval = traceIntervalFactor.empty() ? 10 : max(1, parseInt(traceIntervalFactor));
 
-    // Inicjalizacja wektora wektorów przechowującego potomstwo
-    vector<vector<int>> offspring;
+    return parameters;
+}
+
+// Nieznana nazwa nie może przejść do algorytmu - metody *FromName zamieniają ją na wartość domyślną
+bool ATSP::checkParameterNames(const GAParameters& parameters, string& error) {
+    if (parameters.crossingMethod != "OX" && parameters.crossingMethod != "PMX") {
+        error = "unknown crossover method " + parameters.crossingMethod;
+    } else if (parameters.mutationMethod != InsertionMutation::name &&
+               parameters.mutationMethod != SwapMutation::name) {
+        error = "unknown mutation method " + parameters.mutationMethod;
+    } else if (parameters.selectionMethod != "RW" &&
+               Selection::methodFromName(parameters.selectionMethod) == Selection::Method::Roulette) {
+        error = "unknown selection method " + parameters.selectionMethod;
+    } else if (parameters.successionPolicy != "PARENTS" &&
+               Succession::policyFromName(parameters.successionPolicy) == Succession::Policy::Parents) {
+        error = "unknown succession policy " + parameters.successionPolicy;
+    } else if (parameters.migrationTopology != "RING" && parameters.migrationTopology != "FULL" &&
+               parameters.migrationTopology != "RANDOM") {
+        error = "unknown migration topology " + parameters.migrationTopology;
+    } else if (parameters.localSearchMode != "OFF" && parameters.localSearchMode != "BEST" &&
+               parameters.localSearchMode != "ALL") {
+        error = "unknown local search mode " + parameters.localSearchMode;
+    } else if (parameters.seedingMethod != "RANDOM" &&
+               TourBuilder::methodFromName(parameters.seedingMethod) == TourBuilder::Method::Random) {
+        error = "unknown seeding method " + parameters.seedingMethod;
+    } else if (parameters.boundMethod != "OFF" &&
+               LowerBound::methodFromName(parameters.boundMethod) == LowerBound::Method::None) {
+        error = "unknown lower bound method " + parameters.boundMethod;
+    } else {
+        return true;
+    }
+    return false;
+}
 
-    // Inicjalizacja populacji początkowej
-    for (int i = 0; i < populationSize; i++) {
-        vector<int> chromosome;
-        generateRandomChromosome(chromosome);
-        currentPopulation.push_back(chromosome);
+// Parametry przekazane bezpośrednio (z pominięciem parseParameters) nie mogą doprowadzić do pustej
+// populacji ani dzielenia przez zerowy interwał migracji, punktu kontrolnego lub przebiegu zbieżności
+bool ATSP::checkParameters(const GAParameters& parameters, string& error) {
+    if (!checkParameterNames(parameters, error)) {
+        return false;
+    }
+    if (!(parameters.seedingRatio >= 0.0 && parameters.seedingRatio <= 1.0)) {
+        error = "seeding ratio must be between 0 and 1";
+    } else if (parameters.populationSize < 2 || !(parameters.maxExecutionTime > 0.0)) {
+        error = "population must be at least 2 and time must be positive";
+    } else if (parameters.threadCount < 1 || parameters.islandCount < 1) {
+        error = "thread and island counts must be at least 1";
+    } else if (parameters.migrationInterval < 1 || parameters.checkpointInterval < 1 ||
+               parameters.traceInterval < 1) {
+        error = "migration, checkpoint and trace intervals must be at least 1";
+    } else {
+        return true;
     }
+    return false;
+}
 
-    // Sortowanie populacji początkowej względem kosztu trasy
-    sortByCost(currentPopulation);
+// Metoda wykonująca algorytm genetyczny dla wczytanej instancji i zwracająca jego wynik
+GAResult ATSP::solve(GAParameters parameters, const SolveControl* control) {
 
-    // Inicjalizacja wektora przechowującego najlepszy chromosom (trasę)
-    vector<int> bestChromosome = currentPopulation[0];
+    GAResult result;
+
+    // Tablica najlepszej trasy kodu osadzającego albo własna (gdy podano tylko wywołanie zwrotne)
+    BestTourBoard ownBoard;
+    BestTourBoard* board = control != nullptr ? control->board : nullptr;
+    if (control != nullptr && board == nullptr && control->onImprovement) {
+        ownBoard.prepare(V);
+        board = &ownBoard;
+    }
+
+    // Klucze skrótów tras tylko dla eliminacji duplikatów lub pamięci kosztów (bez nich pętla
+    // pokolenia nie oblicza skrótów)
+    tourHash.prepare(parameters.rejectDuplicates || parameters.costCacheSize > 0 ? V : 0);
+
+    const bool checkpointing = !parameters.checkpointFile.empty();
+
+    // Wznowienie obliczeń z punktu kontrolnego zgodnego z instancją i konfiguracją
+    Checkpoint checkpoint;
+    bool resumed = false;
+    if (checkpointing) {
+        checkpoint.prepare(distanceProvider, parameters.seed, parameters.islandCount, parameters.populationSize,
+                           parameters.islandCount == 1 ? parameters.threadCount : 1);
+        string error;
+        resumed = checkpoint.load(parameters.checkpointFile, error);
+        if (!error.empty()) {
+            result.warnings.push_back(error);
+        }
+        if (resumed) {
+            parameters.seed = checkpoint.seed();
+
+            // Populacja wznowionych obliczeń pochodzi z punktu kontrolnego - bez budowy heurystycznej
+            parameters.seedingMethod = "RANDOM";
+        }
+    }
+
+    // Listy kandydatów przeszukiwania lokalnego i heurystyk konstrukcyjnych budowane raz dla instancji
+    if (parameters.localSearchMode != "OFF" ||
+        TourBuilder::methodFromName(parameters.seedingMethod) != TourBuilder::Method::Random) {
+        candidateLists.build(distanceProvider, parameters.candidateListSize);
+    }
+
+    // Przebieg zbieżności zapisywany w tle (wątki wysp tylko odkładają rekordy do buforów)
+    ConvergenceTrace trace;
+    if (!parameters.traceFile.empty() && !trace.open(parameters.traceFile, parameters.islandCount, V)) {
+        result.warnings.push_back("cannot open the trace file " + parameters.traceFile);
+    }
+    const bool tracing = trace.isOpen();
+
+    // Wariant pokolenia dla wybranych operatorów wybierany raz przed rozpoczęciem obliczeń
+    const GenerationStep step = generationStep(parameters);
+
+    // Dolne ograniczenie kosztu trasy (liczone przed rozpoczęciem pomiaru czasu obliczeń)
+    const LowerBound::Method boundMethod = LowerBound::methodFromName(parameters.boundMethod);
+    if (boundMethod != LowerBound::Method::None) {
+        if (V > LowerBound::MaxDimension) {
+            result.warnings.push_back("lower bound skipped, instance larger than " +
+                                      to_string(LowerBound::MaxDimension) + " cities");
+        } else {
+            Timer boundTimer;
+            result.lowerBound = LowerBound::compute(distanceProvider, boundMethod, parameters.boundIterations);
+            result.lowerBoundComputed = true;
+            result.boundTime = boundTimer.elapsedSeconds();
+        }
+    }
+
+    // Koszt, przy którym różnica względem dolnego ograniczenia mieści się w dopuszczalnej luce
+    const long long gapCost = result.lowerBoundComputed
+                              ? result.lowerBound + static_cast<long long>(
+                                      floor(llabs(result.lowerBound) * parameters.gapPercent / 100.0))
+                              : numeric_limits<long long>::min();
+
+    Individual bestIndividual;
 
     // Początkowy czas wykonania algorytmu
-    startTime = read_QPC();
+    Timer timer;
+
+    // Czas obliczeń wraz z czasem przebiegu przerwanego w punkcie kontrolnym
+    auto elapsedTime = [&]() {
+        return checkpoint.elapsedTime() + timer.elapsedSeconds();
+    };
+
+    // Osiągnięcie kosztu docelowego lub luki względem dolnego ograniczenia przez którąkolwiek wyspę
+    // kończy obliczenia. Lepsza od opublikowanej trasa wyspy trafia do tablicy najlepszej trasy
+    // (porównanie kosztu jest odczytem atomowym, więc bez poprawy sprawdzenie nic nie kosztuje)
+    atomic<bool> targetReached{false};
+    atomic<bool> gapReached{false};
+    auto checkTarget = [&](const Island& island) {
+        if (parameters.targetCost > 0 && island.bestIndividual.cost <= parameters.targetCost) {
+            targetReached.store(true, memory_order_relaxed);
+        }
+        if (island.bestIndividual.cost <= gapCost) {
+            gapReached.store(true, memory_order_relaxed);
+        }
+        if (board != nullptr && !island.bestIndividual.dirty && island.bestIndividual.cost < board->cost()) {
+            board->offer(island.bestIndividual.cost, island.bestIndividual.chromosome, elapsedTime(),
+                         control->onImprovement);
+        }
+    };
+
+    // Funkcja sprawdzająca kryterium stopu (czas wykonania, osiągnięty koszt docelowy, luka
+    // lub anulowanie przez kod osadzający)
+    auto stopRequested = [&]() {
+        return elapsedTime() > parameters.maxExecutionTime || targetReached.load(memory_order_relaxed) ||
+               gapReached.load(memory_order_relaxed) ||
+               (control != nullptr && control->cancelled());
+    };
+
+    // Kryteria stopu pojedynczej wyspy: limit pokoleń i stagnacja (brak poprawy najlepszej trasy
+    // przez stagnationLimit pokoleń). W modelu wyspowym obliczenia kończą się, gdy zatrzymają się
+    // wszystkie wyspy. Zwracana jest nazwa kryterium (nullptr - wyspa kontynuuje obliczenia)
+    auto islandStopReason = [&](const Island& island) -> const char* {
+        if (parameters.maxGenerations > 0 && island.generation >= parameters.maxGenerations) {
+            return "GENERATIONS";
+        }
+        if (parameters.stagnationLimit > 0 &&
+            island.generation - island.improvementGeneration >= parameters.stagnationLimit) {
+            return "STAGNATION";
+        }
+        return nullptr;
+    };
+
+    if (parameters.islandCount == 1) {
+        // Jedna populacja, której etapy wykonywane są równolegle przez pulę wątków
+        ThreadPool pool(parameters.threadCount);
+        Island island;
+
+        // Czas tworzenia populacji początkowej mierzony osobno i niewliczany do czasu obliczeń
+        Timer seedingTimer;
+        initializeIsland(island, 0, parameters, pool);
+        if (resumed) {
+            checkpoint.restore(island, 0);
+        }
+        result.seedingTime = seedingTimer.elapsedSeconds();
+        timer.restart();
+
+        island.improvementGeneration = island.generation;
+        const long long firstGeneration = island.generation;
+        if (tracing) {
+            trace.record(0, elapsedTime(), island);
+        }
+
+        // Pomiar alokacji wątków tego przebiegu (wątek wywołujący i wątki puli) - tylko przy
+        // GA_ALLOCATION_COUNTING. parallelFor(pool.size()) przydziela każdemu wątkowi dokładnie jeden
+        // fragment (fragment 0 wykonuje wątek wywołujący), więc każdy odczytuje własny licznik wątku
+        vector<long long> workerAllocations(pool.size());
+        auto runAllocations = [&]() {
+            pool.parallelFor(pool.size(), [&](int, int, int worker) {
+                workerAllocations[worker] = AllocationCounter::threadAllocations();
+            });
+            long long total = 0;
+            for (long long count : workerAllocations) {
+                total += count;
+            }
+            return total;
+        };
+        long long allocationsBefore = 0;
+
+        // Pętla główna algorytmu, wykonująca się do momentu przekroczenia czasu wykonania
+        checkTarget(island);
+        while (!stopRequested() && islandStopReason(island) == nullptr) {
+            (this->*step)(island, parameters, pool);
+            checkTarget(island);
+
+            if (AllocationCounter::Enabled && island.generation == firstGeneration + 1) {
+                allocationsBefore = runAllocations();
+            }
 
-    // Pętla główna algorytmu, wykonująca się do momentu przekroczenia czasu wykonania
-    while (((1.0 * (read_QPC() - startTime)) / frequency) <= maxExecutionTime) {
+            if (tracing && island.generation % parameters.traceInterval == 0) {
+                trace.record(0, elapsedTime(), island);
+            }
 
-        // Obliczenie wartości przystosowania dla każdego chromosomu w populacji
-        double fitnessSum = 0.0;
+            if (checkpointing && island.generation % parameters.checkpointInterval == 0) {
+                checkpoint.capture(island, 0);
+                checkpoint.save(parameters.checkpointFile, elapsedTime());
+            }
+        }
 
-        for (const auto &chromosome: currentPopulation) {
-            double fitnessValue = (1.0 / calculateCost(chromosome));
-            fitnessSum += fitnessValue;
-            fitnessValues.push_back(fitnessValue);
+        if (AllocationCounter::Enabled && island.generation > firstGeneration) {
+            result.steadyStateAllocations = runAllocations() - allocationsBefore;
         }
 
-        // Na podstawie przystosowania, obliczenie wartości prawdopodobieństwa osobnika
-        double sumOfProbabilities = 0.0;
+        if (checkpointing) {
+            checkpoint.capture(island, 0);
+        }
 
-        for (const auto value: fitnessValues) {
-            double probability = sumOfProbabilities + (value / fitnessSum);
-            sumOfProbabilities = probability;
-            probabilities.push_back(probability);
+        if (islandStopReason(island) != nullptr) {
+            result.stopReason = islandStopReason(island);
         }
 
-        // Selekcja rodziców na podstawie funkcji przystosowania (ruletka)
-        int parentIndex;
-        for (int i = 0; i < populationSize; i++) {
+        bestIndividual = island.bestIndividual;
+        result.generations = island.generation;
+        result.profiler.merge(island.profiler);
+        for (long long count : island.evaluationCounts) {
+            result.evaluations += count;
+        }
+        for (long long hits : island.cacheHits) {
+            result.cacheHits += hits;
+        }
+        result.duplicatesRejected = island.succession.rejectedDuplicates();
 
-            // Wylosowanie rodzica
-            parentIndex = rouletteWheel(probabilities);
+    } else {
+        // Model wyspowy - każda wyspa ewoluuje w osobnym wątku
+        vector<unique_ptr<Island>> islands;
+        for (int k = 0; k < parameters.islandCount; k++) {
+            islands.push_back(make_unique<Island>());
+        }
 
-            // Dodaj wybranych rodziców do wektora rodziców
-            parents.push_back(currentPopulation[parentIndex]);
+        // Równoległe tworzenie populacji początkowych wszystkich wysp przed rozpoczęciem pomiaru czasu
+        Timer seedingTimer;
+        vector<thread> islandThreads;
+        for (int k = 0; k < parameters.islandCount; k++) {
+            islandThreads.emplace_back([&, k]() {
+                ThreadPool pool(1);
+                initializeIsland(*islands[k], k, parameters, pool);
+                if (resumed) {
+                    checkpoint.restore(*islands[k], k);
+                }
+            });
+        }
+        for (auto& islandThread : islandThreads) {
+            islandThread.join();
         }
+        result.seedingTime = seedingTimer.elapsedSeconds();
+        timer.restart();
+
+        islandThreads.clear();
+        for (int k = 0; k < parameters.islandCount; k++) {
+            islandThreads.emplace_back([&, k]() {
+                ThreadPool pool(1);
+                Island& island = *islands[k];
+
+                island.improvementGeneration = island.generation;
+                if (tracing) {
+                    trace.record(k, elapsedTime(), island);
+                }
 
-        // Krzyżowanie (crossover)
-        for (int i = 0; i < parents.size(); i++) {
+                checkTarget(island);
+                while (!stopRequested() && islandStopReason(island) == nullptr) {
+                    (this->*step)(island, parameters, pool);
+                    checkTarget(island);
 
-            if (generateRandomDouble(0.0, 1.0) <= crossoverRate) {
+                    // Wymiana najlepszych osobników co migrationInterval pokoleń
+                    if (island.generation % parameters.migrationInterval == 0) {
+                        GA_PROFILE_PHASE(island.profiler, 0, Phase::Migration);
+                        migrate(islands, k, parameters);
+                    }
 
-                vector<int> child;
+                    if (tracing && island.generation % parameters.traceInterval == 0) {
+                        trace.record(k, elapsedTime(), island);
+                    }
 
-                // Wybór metody krzyżowania (OX lub PMX)
-                if (crossingMethod == "OX") {
-                    child = crossoverOX(parents[i], parents[(i + 1) % parents.size()]);
-                } else if (crossingMethod == "PMX") {
-                    child = crossoverPMX(parents[i], parents[(i + 1) % parents.size()]);
+                    // Każda wyspa odkłada swój stan, a plik zapisuje wyspa 0
+                    if (checkpointing && island.generation % parameters.checkpointInterval == 0) {
+                        checkpoint.capture(island, k);
+                        if (k == 0) {
+                            checkpoint.save(parameters.checkpointFile, elapsedTime());
+                        }
+                    }
                 }
+            });
+        }
 
-                // Dodaj potomstwo do nowej populacji
-                offspring.push_back(child);
+        for (auto& islandThread : islandThreads) {
+            islandThread.join();
+        }
 
-            } else {
-                // Jeśli nie krzyżujemy, to skopiuj rodziców do potomstwa
-                offspring.push_back(parents[i]);
+        if (checkpointing) {
+            for (int k = 0; k < parameters.islandCount; k++) {
+                checkpoint.capture(*islands[k], k);
             }
         }
 
-        // Mutacja (mutation)
-        for (auto &chromosome: offspring) {
+        // Wszystkie wyspy zatrzymane własnym kryterium (pierwsze z nich jest przyczyną zakończenia)
+        const bool islandsStopped = all_of(islands.begin(), islands.end(), [&](const unique_ptr<Island>& island) {
+            return islandStopReason(*island) != nullptr;
+        });
+        if (islandsStopped) {
+            result.stopReason = islandStopReason(*islands[0]);
+        }
 
-            // Sprawdzenie czy ma zajść mutacja na podstawie współczynnika mutacji
-            if (generateRandomDouble(0.0, 1.0) <= mutationRate) {
-                // Wywołanie funkcji mutacji wstawieniowej
-                insertionMutation(chromosome);
+        // Wybór najlepszego osobnika spośród wszystkich wysp
+        bestIndividual = islands[0]->bestIndividual;
+        for (const auto& island : islands) {
+            result.generations += island->generation;
+            result.profiler.merge(island->profiler);
+            for (long long count : island->evaluationCounts) {
+                result.evaluations += count;
+            }
+            for (long long hits : island->cacheHits) {
+                result.cacheHits += hits;
+            }
+            result.duplicatesRejected += island->succession.rejectedDuplicates();
+            if (island->bestIndividual.cost < bestIndividual.cost) {
+                bestIndividual = island->bestIndividual;
             }
         }
+    }
 
-        // Sukcesja (wybranie najlepszej puli osobników z dwóch pokoleń)
-        succession(currentPopulation, parents, offspring);
+    // Zakończenie pomiaru czasu
+    result.executionTime = elapsedTime();
+    result.runTime = timer.elapsedSeconds();
 
-        // Aktualizacja najlepszego chromosomu, jeśli znaleziono lepszy
-        if (calculateCost(currentPopulation[0]) < calculateCost(bestChromosome)) {
-            bestChromosome = currentPopulation[0];
-        }
+    // Zapis pozostałych punktów przebiegu
+    trace.close();
+    result.tracePoints = trace.written();
+    result.traceDropped = trace.dropped();
 
-        // Wyczyszczenie wektorów pomocniczych przed kolejną iteracją
-        fitnessValues.clear();
-        probabilities.clear();
-        parents.clear();
-        offspring.clear();
+    // Zapis końcowego stanu - kolejne uruchomienie z tym plikiem kontynuuje obliczenia
+    if (checkpointing && !checkpoint.save(parameters.checkpointFile, result.executionTime)) {
+        result.warnings.push_back("cannot save the checkpoint " + parameters.checkpointFile);
     }
 
-    // Zakończenie pomiaru czasu
-    endTime = read_QPC();
+    result.geneBits = 8 * PopulationArena::geneWidthFor(V);
+    result.distanceBits = distanceProvider.distanceBits();
+    result.distanceStorage = DistanceProvider::storageName(distanceProvider.storage());
+    result.distanceBytes = distanceProvider.byteSize();
+    result.bestTour = bestIndividual.chromosome;
+    result.bestCost = bestIndividual.cost;
+    result.seed = parameters.seed;
+    result.resumed = resumed;
+    result.targetReached = targetReached.load();
+    if (result.targetReached) {
+        result.stopReason = "TARGET";
+    } else if (gapReached.load()) {
+        result.stopReason = "GAP";
+    } else if (result.stopReason == "TIME" && control != nullptr && control->cancelled()) {
+        result.stopReason = "CANCELLED";
+    }
+    return result;
+}
+
+// Metoda wyświetlająca wynik algorytmu genetycznego
+void ATSP::printResult(const GAParameters& parameters, const GAResult& result) {
+
+    if (result.resumed) {
+        cout << "Wznowiono z punktu kontrolnego: " << parameters.checkpointFile << endl;
+    }
 
-    // Wyświetlenie wyników
     cout << "Najlepsza trasa znaleziona algorytmem GA: ";
-    for (int gene : bestChromosome) {
+    for (int gene : result.bestTour) {
         cout << gene << " -> ";
     }
-    cout << bestChromosome[0] << endl;
+    cout << result.bestTour[0] << endl;
 
     cout << "--------------------------------" << endl;
-    cout << "Koszt najlepszej trasy: " << calculateCost(bestChromosome) << endl;
+    cout << "Koszt najlepszej trasy: " << result.bestCost << endl;
     cout << "--------------------------------" << endl;
-    cout << "Czas wykonania: " << ((1.0 * (endTime - startTime)) / frequency) << "s" << endl;
+    cout << "Czas wykonania: " << result.executionTime << "s" << endl;
+    if (result.lowerBoundComputed) {
+        cout << "Dolne ograniczenie (" << parameters.boundMethod << "): " << result.lowerBound << ", luka "
+             << fixed << setprecision(2) << result.gapPercent() << "%" << defaultfloat << ", czas "
+             << result.boundTime << "s" << endl;
+    }
+    cout << "Kryterium stopu: " << result.stopReason << endl;
+    if (parameters.seedingMethod != "RANDOM") {
+        cout << "Populacja poczatkowa: " << parameters.seedingMethod << " ("
+             << static_cast<int>(parameters.seedingRatio * 100) << "%), czas " << result.seedingTime << "s" << endl;
+    }
+    cout << "--------------------------------" << endl;
+    cout << "Liczba pokolen: " << result.generations << endl;
+    if (result.executionTime > 0.0) {
+        cout << "Pokolenia na sekunde: " << static_cast<long long>(result.generationsPerSecond()) << endl;
+    }
+    if (result.runTime > 0.0) {
+        cout << "Obliczenia kosztu na sekunde: " << static_cast<long long>(result.evaluationsPerSecond()) << endl;
+    }
+    cout << "Metoda mutacji: " << parameters.mutationMethod << endl;
+    cout << "Metoda selekcji: " << parameters.selectionMethod << endl;
+    cout << "Strategia sukcesji: " << parameters.successionPolicy << endl;
+    cout << "Przeszukiwanie lokalne: " << parameters.localSearchMode << endl;
+    cout << "Ziarno generatora: " << result.seed << endl;
+    if (parameters.rejectDuplicates) {
+        cout << "Odrzucone duplikaty: " << result.duplicatesRejected << endl;
+    }
+    if (parameters.costCacheSize > 0) {
+        cout << "Koszty z pamieci kosztow: " << result.cacheHits << endl;
+    }
+    cout << "Reprezentacja: geny " << result.geneBits << "-bit, odleglosci " << result.distanceBits << "-bit ("
+         << result.distanceStorage << ", " << result.distanceBytes / 1024 << " KB)" << endl;
+    if (parameters.islandCount == 1) {
+        cout << "Liczba watkow: " << parameters.threadCount << endl;
+        if (result.steadyStateAllocations >= 0) {
+            cout << "Alokacje pamieci w petli glownej: " << result.steadyStateAllocations << endl;
+        }
+    } else {
+        cout << "Liczba wysp: " << parameters.islandCount << endl;
+    }
+    if (!parameters.traceFile.empty()) {
+        cout << "Przebieg zbieznosci: " << parameters.traceFile << " (punkty: " << result.tracePoints
+             << ", pominiete: " << result.traceDropped << ")" << endl;
+    }
+#ifdef GA_PROFILING
+    cout << "--------------------------------" << endl;
+    result.profiler.report(cout);
+#endif
     cout << "--------------------------------" << endl;
     cout << endl;
 }
 
-// Metoda generująca jedną losową drogę (chromosom)
-void ATSP::generateRandomChromosome(vector<int>& chromosome) {
+// Metoda tworząca populację początkową wyspy o numerze islandIndex - część seedingRatio populacji
+// budowana jest heurystyką konstrukcyjną (NN, GREEDY, INSERTION lub MIX), pozostałe trasy są losowe
+void ATSP::initializeIsland(Island& island, int islandIndex, const GAParameters& parameters, ThreadPool& pool) {
+
+    const int populationSize = parameters.populationSize;
+
+    // Bufory przeszukiwania lokalnego tylko wtedy, gdy jest ono włączone
+    const bool localSearch = parameters.localSearchMode != "OFF";
+
+    // Osobny strumień liczb losowych dla każdego wątku roboczego - przy ustalonym ziarnie
+    // i liczbie wątków kolejne pokolenia są identyczne niezależnie od szeregowania wątków
+    island.randoms.clear();
+    island.scratch.clear();
+    island.localSearches.clear();
+    for (int worker = 0; worker < pool.size(); worker++) {
+        island.randoms.push_back(Random::forStream(parameters.seed,
+                                                   static_cast<uint64_t>(islandIndex) * pool.size() + worker));
+        island.scratch.emplace_back();
+        island.scratch.back().resize(V);
+        if (localSearch) {
+            island.localSearches.emplace_back();
+            island.localSearches.back().prepare(V);
+        }
+    }
 
-    // Inicjalizacja wektora kolejnych numerów miast
-    for (int i = 0; i < V; i++) {
-        chromosome.push_back(i);
+    // Jednorazowa alokacja wszystkich chromosomów i struktur pomocniczych pokolenia
+    island.arena.allocate(populationSize, V, PopulationArena::geneWidthFor(V));
+    island.parents.assign(populationSize, 0);
+    island.succession.prepare(populationSize);
+    island.migrationTargets.reserve(parameters.islandCount);
+    island.profiler.prepare(pool.size());
+    island.evaluationCounts.assign(pool.size(), 0);
+    island.costCaches.resize(pool.size());
+    for (CostCache& cache : island.costCaches) {
+        cache.prepare(parameters.costCacheSize);
+    }
+    island.cacheHits.assign(pool.size(), 0);
+    island.bestIndividual.chromosome.assign(V, 0);
+    island.bestIndividual.markDirty();
+    island.generation = 0;
+    island.improvementGeneration = 0;
+
+    PopulationArena& arena = island.arena;
+
+    // Część populacji budowana heurystyką konstrukcyjną (pozostałe trasy są losowe). Pierwsze trasy
+    // każdej heurystyki budowane są bez zaburzenia kosztów łuków
+    const TourBuilder::Method seeding = TourBuilder::methodFromName(parameters.seedingMethod);
+    const int heuristicCount = seeding == TourBuilder::Method::Random ? 0 : max(0, min(populationSize,
+            static_cast<int>(lround(parameters.seedingRatio * populationSize))));
+    const int exactCount = seeding == TourBuilder::Method::Mix ? 3 : 1;
+    vector<TourBuilder> builders(heuristicCount > 0 ? pool.size() : 0);
+    for (TourBuilder& builder : builders) {
+        builder.prepare(V);
     }
 
-    // Inicjalizacja generatora liczb pseudolosowych
-    random_device rd;
-    mt19937 generator(rd());
+    // Inicjalizacja populacji początkowej (wraz z jednokrotnym obliczeniem kosztu)
+    pool.parallelFor(populationSize, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; i++) {
+            arena.visitGenes(arena.currentSlot(i), [&](auto* genes) {
+                if (i < heuristicCount) {
+                    distanceProvider.visit([&](const auto& distances) {
+                        builders[worker].build(TourBuilder::methodFor(seeding, i), distances, candidateLists, genes,
+                                               island.randoms[worker], i < exactCount ? 0.0 : SeedingNoise);
+                    });
+                } else {
+                    generateRandomChromosome(genes, island.randoms[worker]);
+                }
+            });
+            arena.setDirty(arena.currentSlot(i), true);
+            evaluate(arena, arena.currentSlot(i));
+        }
+    });
 
-    // Mieszanie wektora w losowej kolejności
-    shuffle(chromosome.begin(), chromosome.end(), generator);
-}
+    island.evaluationCounts[0] += populationSize;
 
-// Metoda do sortowania malejącego wektora osobników w populacji
-void ATSP::sortByCost(vector<vector<int>>& population) {
-    sort(population.begin(), population.end(), [this](const auto &a, const auto &b) {
-        return calculateCost(a) < calculateCost(b);
-    });
+    // Przeniesienie najlepszego osobnika populacji początkowej na pozycję 0
+    vector<int>& population = arena.populationSlots();
+    iter_swap(population.begin(), min_element(population.begin(), population.end(), [&arena](int a, int b) {
+        return arena.cost(a) < arena.cost(b);
+    }));
+
+    // Inicjalizacja najlepszego chromosomu (trasy)
+    updateBestIndividual(island);
 }
 
-// Metoda oblaczająca koszt drogi
-int ATSP::calculateCost(const vector<int>& chromosome) {
-    int cost = 0;
+// Metoda wykonująca jedno pokolenie algorytmu genetycznego na wyspie. Operatory są parametrami
+// szablonu, więc w pętlach pokolenia nie ma porównań nazw metod ani wywołań pośrednich
+template<typename Gene, typename Distances, typename Crossover, typename Mutation, typename SelectionPolicy,
+        typename SuccessionPolicy, int FixedDimension>
+void ATSP::evolveGeneration(Island& island, const GAParameters& parameters, ThreadPool& pool) {
+
+    const int populationSize = parameters.populationSize;
+    const Distances distances = distanceProvider.view<Distances>();
+    const bool improveAll = parameters.localSearchMode == "ALL";
+    const bool improveBest = parameters.localSearchMode == "BEST";
+    const bool hashing = !tourHash.empty();
+    PopulationArena& arena = island.arena;
+    vector<int>& parents = island.parents;
+
+    [[maybe_unused]] Profiler& profiler = island.profiler;
+
+    // Przyjęcie migrantów przesłanych przez inne wyspy
+    {
+        GA_PROFILE_PHASE(profiler, 0, Phase::Migration);
+        acceptMigrants(island);
+    }
 
-    for (int i = 0; i < V - 1; ++i) {
-        cost += distanceMatrix[chromosome[i]][chromosome[i + 1]];
+    // Przygotowanie selekcji (przystosowanie, prawdopodobieństwa lub tablice aliasów)
+    {
+        GA_PROFILE_PHASE(profiler, 0, Phase::Probabilities);
+        island.selection.prepare(arena.currentCosts(), populationSize, SelectionPolicy::method,
+                                 parameters.tournamentSize);
     }
 
-    // Dodanie kosztu powrotu do pierwszego miasta (cyklu)
-    cost += distanceMatrix[chromosome[V - 1]][chromosome[0]];
+    // Selekcja rodziców wybraną metodą (rodzice wskazywani są indeksami osobników)
+    pool.parallelFor(populationSize, [&](int begin, int end, int worker) {
+        GA_PROFILE_PHASE(profiler, worker, Phase::Selection);
+        for (int i = begin; i < end; i++) {
+            parents[i] = SelectionPolicy::select(island.selection, island.randoms[worker]);
+        }
+    });
 
-    return cost;
-}
+    // Krzyżowanie, mutacja i obliczenie kosztu - niezależne dla każdej pary rodziców
+    // (rodzice 2p i 2p + 1 dają potomków 2p i 2p + 1), potomkowie zapisywani są
+    // bezpośrednio do swoich slotów w arenie
+    const int pairCount = (populationSize + 1) / 2;
+    pool.parallelFor(pairCount, [&](int begin, int end, int worker) {
+        Random& random = island.randoms[worker];
+        CrossoverScratch& scratch = island.scratch[worker];
+
+        for (int pair = begin; pair < end; pair++) {
+            const int first = 2 * pair;
+            const bool hasSecondChild = first + 1 < populationSize;
+
+            const int parent1Slot = arena.currentSlot(parents[first]);
+            const int parent2Slot = arena.currentSlot(parents[(first + 1) % populationSize]);
+            const int child1Slot = arena.offspringSlot(first);
+            const int child2Slot = hasSecondChild ? arena.offspringSlot(first + 1) : -1;
+            Gene* child1 = arena.genes<Gene>(child1Slot);
+            Gene* child2 = hasSecondChild ? arena.genes<Gene>(child2Slot) : nullptr;
+
+            // Krzyżowanie (crossover)
+            {
+                GA_PROFILE_PHASE(profiler, worker, Phase::Crossover);
+                if (random.nextDouble() <= parameters.crossoverRate) {
+                    Crossover::template cross<FixedDimension>(V, arena.genes<Gene>(parent1Slot),
+                                                              arena.genes<Gene>(parent2Slot), child1, child2,
+                                                              scratch, random);
+                    arena.setDirty(child1Slot, true);
+                    if (hasSecondChild) {
+                        arena.setDirty(child2Slot, true);
+                    }
 
-// Metoda do wyboru osobnika na podstawie prawdopodobieństw (metoda koła ruletki)
-int ATSP::rouletteWheel(const vector<double>& probabilities) {
+                } else {
+                    // Jeśli nie krzyżujemy, to skopiuj rodziców do potomstwa (wraz z kosztem)
+                    arena.copySlot(parent1Slot, child1Slot);
+                    if (hasSecondChild) {
+                        arena.copySlot(parent2Slot, child2Slot);
+                    }
+                }
+            }
 
-    double randomValue = generateRandomDouble(0.0, 1.0);
+            // Mutacja (mutation) każdego potomka na podstawie współczynnika mutacji
+            GA_PROFILE_PHASE(profiler, worker, Phase::Mutation);
+            for (int i = first; i < first + (hasSecondChild ? 2 : 1); i++) {
+                if (random.nextDouble() <= parameters.mutationRate) {
+                    Mutation::template mutate<FixedDimension, Gene>(distances, tourHash, arena,
+                                                                    arena.offspringSlot(i), random);
+                }
+            }
+        }
 
-    // Znajdź osobnika, którego przedział zawiera wylosowaną wartość
-    for (int i = 0; i < probabilities.size(); i++) {
+        // Wsadowe obliczenie kosztu tylko dla zmienionych osobników potomstwa z fragmentu
+        // (ze skrótami tras - z pominięciem tras, których koszt jest w pamięci kosztów)
+        const int firstChild = 2 * begin;
+        const int lastChild = min(2 * end, populationSize);
+        {
+            GA_PROFILE_PHASE(profiler, worker, Phase::Fitness);
+            const int* children = arena.offspringSlots().data() + firstChild;
+            const int evaluated = hashing ? evaluateHashed<Gene>(distances, arena, children, lastChild - firstChild,
+                                                                 island.costCaches[worker],
+                                                                 island.cacheHits[worker])
+                                          : costEvaluator.evaluateBatch<Gene>(distances, arena, children,
+                                                                              lastChild - firstChild);
+            island.evaluationCounts[worker] += evaluated;
+        }
 
-        if (randomValue <= probabilities[i]) {
-            return i;  // Wybrano osobnika i
+        // Przeszukiwanie lokalne wszystkich potomków z fragmentu
+        if (improveAll) {
+            GA_PROFILE_PHASE(profiler, worker, Phase::LocalSearch);
+            for (int i = firstChild; i < lastChild; i++) {
+                improveIndividual<Gene>(distances, arena, arena.offspringSlot(i), island.localSearches[worker]);
+            }
         }
+    });
+
+    // Przeszukiwanie lokalne tylko najlepszego potomka pokolenia
+    if (improveBest) {
+        GA_PROFILE_PHASE(profiler, 0, Phase::LocalSearch);
+        const vector<int>& offspring = arena.offspringSlots();
+        const int bestChild = *min_element(offspring.begin(), offspring.end(), [&arena](int a, int b) {
+            return arena.cost(a) < arena.cost(b);
+        });
+        improveIndividual<Gene>(distances, arena, bestChild, island.localSearches[0]);
+    }
+
+    // Sukcesja (wybranie najlepszej puli osobników z dwóch pokoleń)
+    {
+        GA_PROFILE_PHASE(profiler, 0, Phase::Succession);
+        island.succession.apply(arena, parents, SuccessionPolicy::policy, parameters.replacementCount,
+                                parameters.rejectDuplicates ? &tourHash : nullptr);
+    }
+
+    // Aktualizacja najlepszego chromosomu, jeśli znaleziono lepszy
+    {
+        GA_PROFILE_PHASE(profiler, 0, Phase::BestTracking);
+        updateBestIndividual(island);
     }
 
-    // Jeśli nie wybrano żadnego osobnika (coś poszło nie tak), zwróć -1
-    return -1;
+    island.generation++;
 }
 
-// Metoda krzyżowania OX (Order Crossover)
-vector<int> ATSP::crossoverOX(const vector<int>& parent1, const vector<int>& parent2) {
+namespace {
 
-    int size = parent1.size();
+// Lista rozmiarów problemu, dla których tworzone są warianty pokolenia o rozmiarze ustalonym
+// w czasie kompilacji
+template<int... Dimensions>
+struct DimensionList {
+};
 
-    // Stwórz potomka, inicjalizując go wartościami specjalnymi
-    vector<int> child(size, -1);
+#ifdef GA_FIXED_DIMENSIONS
+// Rozmiary instancji ATSP z biblioteki TSPLIB (br17, ftv33 ... ftv170, p43, ry48p, ft53, ft70,
+// kro124p, rbg323 ... rbg443)
+using FixedDimensions = DimensionList<17, 34, 36, 39, 43, 45, 48, 53, 56, 65, 70, 71, 100, 171, 323, 358, 403, 443>;
+#else
+using FixedDimensions = DimensionList<>;
+#endif
 
-    // Wygeneruj dwa punkty cięcia losowo
-    int cuttingPoint1 = generateRandomInteger(0, size - 1);
-    int cuttingPoint2 = generateRandomInteger(0, size - 1);
+}
 
-    // Upewnij się, że punkty cięcia są różne
-    while (cuttingPoint1 == cuttingPoint2) {
-        cuttingPoint2 = generateRandomInteger(0, size - 1);
+// Wybór wariantu pokolenia - kolejne parametry tekstowe zamieniane są na typy polityk,
+// a ostatni poziom zwraca wskaźnik na skonkretyzowaną metodę ATSP::evolveGeneration
+struct GenerationDispatch {
+    template<typename Gene, typename Distances, typename Crossover, typename Mutation, typename SelectionPolicy,
+            typename SuccessionPolicy, int... Dimensions>
+    static ATSP::GenerationStep withDimension(int V, DimensionList<Dimensions...>) {
+        ATSP::GenerationStep step =
+                &ATSP::evolveGeneration<Gene, Distances, Crossover, Mutation, SelectionPolicy, SuccessionPolicy, 0>;
+        (void) ((V == Dimensions &&
+                 (step = &ATSP::evolveGeneration<Gene, Distances, Crossover, Mutation, SelectionPolicy,
+                         SuccessionPolicy, Dimensions>, true)) || ...);
+        return step;
     }
 
-    // Upewnij się, że cuttingPoint1 < cuttingPoint2
-    if (cuttingPoint1 > cuttingPoint2) {
-        swap(cuttingPoint1, cuttingPoint2);
+    template<typename Gene, typename Distances, typename Dimensions, typename Crossover, typename Mutation,
+            typename SelectionPolicy>
+    static ATSP::GenerationStep withSuccession(const GAParameters& parameters, int V) {
+        switch (Succession::policyFromName(parameters.successionPolicy)) {
+            case Succession::Policy::Plus:
+                return withDimension<Gene, Distances, Crossover, Mutation, SelectionPolicy, PlusSuccession>(
+                        V, Dimensions());
+            case Succession::Policy::Comma:
+                return withDimension<Gene, Distances, Crossover, Mutation, SelectionPolicy, CommaSuccession>(
+                        V, Dimensions());
+            case Succession::Policy::Steady:
+                return withDimension<Gene, Distances, Crossover, Mutation, SelectionPolicy, SteadySuccession>(
+                        V, Dimensions());
+            default:
+                return withDimension<Gene, Distances, Crossover, Mutation, SelectionPolicy, ParentsSuccession>(
+                        V, Dimensions());
+        }
     }
 
-    // Skopiuj segment od rodzica P1 do potomka
-    copy(parent1.begin() + cuttingPoint1, parent1.begin() + cuttingPoint2 + 1, child.begin() + cuttingPoint1);
-
-    // Wypełnij resztę potomka genami z rodzica P2 w kolejności, pomijając istniejące geny
-    int index = cuttingPoint2 + 1;
+    template<typename Gene, typename Distances, typename Dimensions, typename Crossover, typename Mutation>
+    static ATSP::GenerationStep withSelection(const GAParameters& parameters, int V) {
+        switch (Selection::methodFromName(parameters.selectionMethod)) {
+            case Selection::Method::BinarySearch:
+                return withSuccession<Gene, Distances, Dimensions, Crossover, Mutation, BinarySearchSelection>(
+                        parameters, V);
+            case Selection::Method::Alias:
+                return withSuccession<Gene, Distances, Dimensions, Crossover, Mutation, AliasSelection>(
+                        parameters, V);
+            case Selection::Method::Tournament:
+                return withSuccession<Gene, Distances, Dimensions, Crossover, Mutation, TournamentSelection>(
+                        parameters, V);
+            default:
+                return withSuccession<Gene, Distances, Dimensions, Crossover, Mutation, RouletteSelection>(
+                        parameters, V);
+        }
+    }
 
-    // Sprawdź każdy gen z rodzica P2 w kolejności
-    for (int i = cuttingPoint2 + 1; i <= cuttingPoint2 + size; i++) {
-        int gene = parent2[i % size];
+    template<typename Gene, typename Distances, typename Dimensions, typename Crossover>
+    static ATSP::GenerationStep withMutation(const GAParameters& parameters, int V) {
+        if (parameters.mutationMethod == SwapMutation::name) {
+            return withSelection<Gene, Distances, Dimensions, Crossover, SwapMutation>(parameters, V);
+        }
+        return withSelection<Gene, Distances, Dimensions, Crossover, InsertionMutation>(parameters, V);
+    }
 
-        // Sprawdź, czy gen nie jest już w potomku
-        if (find(child.begin(), child.end(), gene) == child.end()) {
-            child[index % size] = gene;
-            index++;
+    template<typename Gene, typename Distances, typename Dimensions>
+    static ATSP::GenerationStep withCrossover(const GAParameters& parameters, int V) {
+        if (parameters.crossingMethod == PartiallyMatchedCrossover::name) {
+            return withMutation<Gene, Distances, Dimensions, PartiallyMatchedCrossover>(parameters, V);
         }
+        return withMutation<Gene, Distances, Dimensions, OrderCrossover>(parameters, V);
     }
 
-    return child;
-}
+    // Typ genu zgodny z szerokością elementów areny i typ widoku odległości zgodny z postacią danych
+    // instancji. Warianty o stałym rozmiarze tworzone są tylko dla pełnej macierzy i typów 16-bitowych,
+    // w których mieszczą się instancje TSPLIB
+    template<typename Gene>
+    static ATSP::GenerationStep withDistances(const GAParameters& parameters, int V,
+                                              const DistanceProvider& distances) {
+        switch (distances.storage()) {
+            case DistanceProvider::Storage::Coordinates:
+                return withCrossover<Gene, CoordinateDistances, DimensionList<>>(parameters, V);
+            case DistanceProvider::Storage::Sparse:
+                return withCrossover<Gene, SparseDistances, DimensionList<>>(parameters, V);
+            default:
+                if (distances.matrix().elementWidth() == sizeof(int32_t)) {
+                    return withCrossover<Gene, DistanceView<int32_t>, DimensionList<>>(parameters, V);
+                }
+                if constexpr (is_same_v<Gene, uint16_t>) {
+                    return withCrossover<Gene, DistanceView<int16_t>, FixedDimensions>(parameters, V);
+                } else {
+                    return withCrossover<Gene, DistanceView<int16_t>, DimensionList<>>(parameters, V);
+                }
+        }
+    }
 
-// Metoda krzyżowania PMX (Partially Matched Crossover)
-vector<int> ATSP::crossoverPMX(const vector<int>& parent1, const vector<int>& parent2) {
+    static ATSP::GenerationStep withRepresentation(const GAParameters& parameters, int V, int geneWidth,
+                                                   const DistanceProvider& distances) {
+        if (geneWidth == sizeof(uint16_t)) {
+            return withDistances<uint16_t>(parameters, V, distances);
+        }
+        return withDistances<int>(parameters, V, distances);
+    }
+};
 
-    int size = parent1.size();
+// Metoda wybierająca wariant pokolenia dla operatorów podanych w parametrach (nieznana metoda
+// krzyżowania - OX), typów genu i odległości oraz rozmiaru wczytanej instancji
+ATSP::GenerationStep ATSP::generationStep(const GAParameters& parameters) const {
+    return GenerationDispatch::withRepresentation(parameters, V, PopulationArena::geneWidthFor(V),
+                                                  distanceProvider);
+}
 
-    // Stwórz dwa potomków, zainicjalizowane genami rodziców
-    vector<int> child1 = parent1;
-    vector<int> child2 = parent2;
+// Metoda zapamiętująca najlepszego osobnika bieżącego pokolenia, jeśli jest lepszy od dotychczasowego
+void ATSP::updateBestIndividual(Island& island) {
 
-    // Mapa przechowująca odwzorowanie genów pomiędzy rodzicami
-    unordered_map<int, int> mapping1;
-    unordered_map<int, int> mapping2;
+    const PopulationArena& arena = island.arena;
+    const int bestSlot = arena.currentSlot(0);
 
-    // Wygeneruj dwa punkty cięcia losowo
-    int cuttingPoint1 = generateRandomInteger(0, size - 1);
-    int cuttingPoint2 = generateRandomInteger(0, size - 1);
+    if (island.bestIndividual.dirty || arena.cost(bestSlot) < island.bestIndividual.cost) {
+        island.improvementGeneration = island.generation;
 
-    // Upewnij się, że punkty cięcia są różne
-    while (cuttingPoint1 == cuttingPoint2) {
-        cuttingPoint2 = generateRandomInteger(0, size - 1);
+        // Chromosom ma już odpowiedni rozmiar, więc kopiowanie nie alokuje pamięci
+        arena.readGenes(bestSlot, island.bestIndividual.chromosome.data());
+        island.bestIndividual.cost = arena.cost(bestSlot);
+        island.bestIndividual.dirty = false;
     }
+}
 
-    // Ustaw punkt początkowy i końcowy dla krzyżowania
-    if (cuttingPoint1 > cuttingPoint2) {
-        swap(cuttingPoint1, cuttingPoint2);
+// Metoda wysyłająca kopie najlepszych osobników wyspy sourceIndex do wysp docelowych
+// zgodnie z topologią migracji: RING (do następnej wyspy), FULL (do wszystkich wysp),
+// RANDOM (do jednej losowo wybranej wyspy)
+void ATSP::migrate(vector<unique_ptr<Island>>& islands, int sourceIndex, const GAParameters& parameters) {
+
+    Island& source = *islands[sourceIndex];
+    PopulationArena& arena = source.arena;
+    const int islandCount = static_cast<int>(islands.size());
+    const int migrantCount = min(parameters.migrantCount, arena.populationSize());
+
+    // Wyznaczenie wysp docelowych
+    vector<int>& targets = source.migrationTargets;
+    targets.clear();
+    if (parameters.migrationTopology == "FULL") {
+        for (int k = 0; k < islandCount; k++) {
+            if (k != sourceIndex) {
+                targets.push_back(k);
+            }
+        }
+    } else if (parameters.migrationTopology == "RANDOM") {
+        int target = source.randoms[0].nextInt(0, islandCount - 2);
+        targets.push_back(target >= sourceIndex ? target + 1 : target);
+    } else {
+        targets.push_back((sourceIndex + 1) % islandCount);
     }
 
-    // Przeprowadź mapowanie genów pomiędzy rodzicami w obszarze cięcia
-    for (int i = cuttingPoint1; i < cuttingPoint2; ++i) {
-        mapping1[parent2[i]] = parent1[i];
-        child1[i] = parent2[i];
+    // Przeniesienie najlepszych osobników na początek populacji (sortowanie częściowe)
+    vector<int>& population = arena.populationSlots();
+    partial_sort(population.begin(), population.begin() + migrantCount, population.end(), [&arena](int a, int b) {
+        return arena.cost(a) < arena.cost(b);
+    });
 
-        mapping2[parent1[i]] = parent2[i];
-        child2[i] = parent1[i];
-    }
+    for (int target : targets) {
+        Island& destination = *islands[target];
+        lock_guard<mutex> lock(destination.inboxMutex);
 
-    // Napraw obszar poniżej cięcia w potomku 1
-    for (int i = 0; i < cuttingPoint1; ++i) {
-        while (mapping1.find(child1[i]) != mapping1.end()) {
-            child1[i] = mapping1[child1[i]];
-        }
-        while (mapping2.find(child2[i]) != mapping2.end()) {
-            child2[i] = mapping2[child2[i]];
-        }
-    }
+        for (int i = 0; i < migrantCount && destination.inboxCount < destination.arena.populationSize(); i++) {
+            if (destination.inboxCount == static_cast<int>(destination.inbox.size())) {
+                destination.inbox.emplace_back();
+            }
 
-    // Napraw obszar powyżej cięcia w potomku 1
-    for (int i = cuttingPoint2; i < child1.size(); ++i) {
-        while (mapping1.find(child1[i]) != mapping1.end()) {
-            child1[i] = mapping1[child1[i]];
-        }
-        while (mapping2.find(child2[i]) != mapping2.end()) {
-            child2[i] = mapping2[child2[i]];
+            // Ponowne wykorzystanie pamięci wcześniej przyjętych migrantów
+            Individual& migrant = destination.inbox[destination.inboxCount++];
+            migrant.chromosome.resize(V);
+            arena.readGenes(arena.currentSlot(i), migrant.chromosome.data());
+            migrant.cost = arena.cost(arena.currentSlot(i));
+            migrant.dirty = false;
         }
     }
-
-    return child1;
 }
 
-// Mutacja przez wstawienie (Insertion Mutation)
-void ATSP::insertionMutation(vector<int>& chromosome) {
-
-    int size = chromosome.size();
+// Metoda zastępująca najgorsze osobniki wyspy migrantami z jej skrzynki odbiorczej
+void ATSP::acceptMigrants(Island& island) {
 
-    // Wybierz dwa punkty mutacji losowo
-    int mutationPoint1 = generateRandomInteger(0, size - 1);
-    int mutationPoint2 = generateRandomInteger(0, size - 1);
+    lock_guard<mutex> lock(island.inboxMutex);
 
-    // Upewnij się, że punkty mutacji są różne
-    while (mutationPoint1 == mutationPoint2) {
-        mutationPoint2 = generateRandomInteger(0, size - 1);
+    PopulationArena& arena = island.arena;
+    const int count = min(island.inboxCount, arena.populationSize());
+    if (count == 0) {
+        return;
     }
 
-    // Wybierz gen do wstawienia
-    int geneToInsert = chromosome[mutationPoint1];
-
-    // Usuń gen z punktu mutacji 1
-    chromosome.erase(chromosome.begin() + mutationPoint1);
+    // Przeniesienie najgorszych osobników na koniec populacji (selekcja częściowa)
+    vector<int>& population = arena.populationSlots();
+    nth_element(population.begin(), population.end() - count, population.end(), [&arena](int a, int b) {
+        return arena.cost(a) < arena.cost(b);
+    });
 
-    // Wstaw gen do punktu mutacji 2
-    chromosome.insert(chromosome.begin() + mutationPoint2, geneToInsert);
+    for (int i = 0; i < count; i++) {
+        const int slot = arena.currentSlot(arena.populationSize() - 1 - i);
+        arena.writeGenes(slot, island.inbox[i].chromosome.data());
+        arena.cost(slot) = island.inbox[i].cost;
+        arena.setDirty(slot, false);
+    }
+    island.inboxCount = 0;
 }
 
-// Metoda do zastępowania gorszych osobników w populacji aktualnej przez lepsze z potomstwa
-void ATSP::succession(vector<vector<int>>& currentPopulation, const vector<vector<int>>& parents, const vector<vector<int>>& offspring) {
-
-    int size = currentPopulation.size();
+// Metoda generująca jedną losową drogę (chromosom)
+template<typename Gene>
+void ATSP::generateRandomChromosome(Gene* chromosome, Random& random) {
 
-    // Połącz populację rodziców i potomstwa
-    currentPopulation = parents;
-    currentPopulation.insert(currentPopulation.end(), offspring.begin(), offspring.end());
+    // Inicjalizacja kolejnych numerów miast
+    for (int i = 0; i < V; i++) {
+        chromosome[i] = static_cast<Gene>(i);
+    }
 
-    // Posortuj po koszcie (od najmniejszego do największego)
-    sortByCost(currentPopulation);
+    // Mieszanie w losowej kolejności (algorytm Fishera-Yatesa)
+    for (int i = V - 1; i > 0; i--) {
+        swap(chromosome[i], chromosome[random.nextInt(0, i)]);
+    }
+}
 
-    // Wybierz najlepsze osobniki do nowej populacji aktualnej
-    currentPopulation.resize(size);
+// Metoda oblaczająca koszt drogi
+int ATSP::calculateCost(const int* chromosome) {
+    return distanceProvider.visit([&](const auto& distances) {
+        return costEvaluator.cost(distances, chromosome);
+    });
 }
 
-// Funkcja do generowania liczby czałkowitej z wybranego zakresu
-int ATSP::generateRandomInteger(int min, int max) {
+// Metoda obliczająca koszt osobnika w slocie areny, jeśli jego chromosom uległ zmianie
+void ATSP::evaluate(PopulationArena& arena, int slot) {
+    if (arena.isDirty(slot)) {
+        arena.cost(slot) = distanceProvider.visit([&](const auto& distances) {
+            return arena.visitGenes(slot, [&](const auto* genes) {
+                return costEvaluator.cost(distances, genes);
+            });
+        });
+        arena.setDirty(slot, false);
+    }
+}
 
-    // Inicjalizacja generatora liczb pseudolosowych
-    random_device rd;
-    mt19937 generator(rd());
+// Metoda obliczająca koszty zmienionych osobników ze wskazanych slotów z użyciem skrótów tras -
+// koszt trasy obecnej w pamięci kosztów (zgodny skrót i skrót kontrolny) jest z niej odczytywany,
+// pozostałe są liczone i dopisywane do pamięci. Zwracana jest liczba faktycznie obliczonych kosztów
+template<typename Gene, typename Distances>
+int ATSP::evaluateHashed(const Distances& distances, PopulationArena& arena, const int* slots, int count,
+                         CostCache& cache, long long& hits) {
+    int evaluated = 0;
+    for (int i = 0; i < count; i++) {
+        const int slot = slots[i];
+        if (!arena.isDirty(slot)) {
+            continue;
+        }
+        const Gene* genes = arena.genes<Gene>(slot);
+        if (!arena.hasHash(slot)) {
+            arena.setHash(slot, tourHash.hash(genes));
+        }
+        if (!cache.enabled()) {
+            continue;
+        }
 
-    // Definicja rozkładu prawdopodobieństwa z zakresu [min, max]
-    uniform_int_distribution<> distribution(min, max);
+        const uint64_t check = tourHash.check(genes);
+        if (cache.find(arena.hash(slot), check, arena.cost(slot))) {
+            hits++;
+        } else {
+            arena.cost(slot) = costEvaluator.cost<Gene>(distances, genes);
+            cache.insert(arena.hash(slot), check, arena.cost(slot));
+            evaluated++;
+        }
+        arena.setDirty(slot, false);
+    }
 
-    // Wygenerowanie liczby zmiennoprzecinkowej z zakresu [min, max]
-    return distribution(generator);
+    // Bez pamięci kosztów skróty potrzebne są tylko do eliminacji duplikatów - koszty liczone wsadowo
+    return evaluated + costEvaluator.evaluateBatch<Gene>(distances, arena, slots, count);
 }
 
-// Funkcja do generowania liczby zmiennoprzecinkowej z wybranego zakresu
-double ATSP::generateRandomDouble(double min, double max) {
+// Metoda poprawiająca osobnika w slocie areny przeszukiwaniem lokalnym (koszt musi być aktualny)
+template<typename Gene, typename Distances>
+void ATSP::improveIndividual(const Distances& distances, PopulationArena& arena, int slot, LocalSearch& localSearch) {
+    const int cost = arena.cost(slot);
+    arena.cost(slot) = localSearch.improve(distances, candidateLists, arena.genes<Gene>(slot), cost);
+
+    // Poprawiona trasa ma inny skrót (obliczany ponownie w sukcesji, jeśli jest potrzebny)
+    if (arena.cost(slot) != cost) {
+        arena.clearHash(slot);
+    }
+}
 
-    // Inicjalizacja generatora liczb pseudolosowych
-    random_device rd;
-    mt19937_64 generator(rd());
+// Metody krzyżowania i mutacji dla rozmiaru podanego w czasie wykonania (GeneticOperators.h)
+void ATSP::crossoverOX(const int* parent1, const int* parent2, int* child, CrossoverScratch& scratch,
+                       Random& random) {
+    OrderCrossover::offspring<0>(V, parent1, parent2, child, scratch, random);
+}
 
-    // Definicja rozkładu prawdopodobieństwa z zakresu [min, max]
-    uniform_real_distribution<double> distribution(min, max);
+void ATSP::crossoverPMX(const int* parent1, const int* parent2, int* child1, int* child2,
+                        CrossoverScratch& scratch, Random& random) {
+    PartiallyMatchedCrossover::cross<0>(V, parent1, parent2, child1, child2, scratch, random);
+}
 
-    // Wygenerowanie liczby zmiennoprzecinkowej z zakresu [min, max]
-    return distribution(generator);
+void ATSP::insertionMutation(PopulationArena& arena, int slot, Random& random) {
+    distanceProvider.visit([&](const auto& distances) {
+        InsertionMutation::mutate<0, int>(distances, tourHash, arena, slot, random);
+    });
 }
 
-long long int ATSP::read_QPC() {
-    LARGE_INTEGER count;
-    QueryPerformanceCounter(&count);
-    return((long long int)count.QuadPart);
+void ATSP::swapMutation(PopulationArena& arena, int slot, Random& random) {
+    distanceProvider.visit([&](const auto& distances) {
+        SwapMutation::mutate<0, int>(distances, tourHash, arena, slot, random);
+    });
 }
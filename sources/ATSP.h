@@ -2,16 +2,178 @@
 #define GENETIC_ALGORITHM_ATSP_H
 
 
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 #include <set>
 #include <limits>
+#include <memory>
+
+#include "Individual.h"
+#include "DistanceProvider.h"
+#include "CostEvaluator.h"
+#include "Random.h"
+#include "Island.h"
+#include "PopulationArena.h"
+#include "Moves.h"
+#include "LocalSearch.h"
+#include "GeneticOperators.h"
+#include "TourHash.h"
+#include "SolveControl.h"
+
+class ThreadPool;
 
 using namespace std;
 
 // Wszystkie metody i ich działanie opisano w pliku ATSP.cpp
 
+// Parametry algorytmu genetycznego po konwersji z postaci tekstowej
+struct GAParameters {
+    string crossingMethod;
+    double maxExecutionTime = 0.0;
+    int populationSize = 0;
+    double crossoverRate = 0.0;
+    double mutationRate = 0.0;
+    uint64_t seed = 0;
+    int threadCount = 1;
+
+    // Operator mutacji: INSERTION - przeniesienie genu, SWAP - zamiana dwóch genów miejscami
+    string mutationMethod = "INSERTION";
+
+    // Metoda selekcji (RW, BS, ALIAS, TOUR) oraz rozmiar turnieju
+    string selectionMethod = "RW";
+    int tournamentSize = 2;
+
+    // Strategia sukcesji (PARENTS, PLUS, COMMA, STEADY) oraz liczba osobników
+    // wymienianych w jednym pokoleniu w modelu stacjonarnym
+    string successionPolicy = "PARENTS";
+    int replacementCount = 1;
+
+    // Przeszukiwanie lokalne potomstwa (tryb memetyczny): OFF - wyłączone,
+    // BEST - tylko najlepszy potomek pokolenia, ALL - wszyscy potomkowie
+    string localSearchMode = "OFF";
+    int candidateListSize = 8;
+
+    // Model wyspowy: liczba wysp, co ile pokoleń następuje migracja,
+    // ilu najlepszych osobników migruje oraz topologia (RING, FULL, RANDOM)
+    int islandCount = 1;
+    int migrationInterval = 50;
+    int migrantCount = 2;
+    string migrationTopology = "RING";
+
+    // Punkt kontrolny: plik (pusty - wyłączony) oraz co ile pokoleń zapisywany jest stan.
+    // Istniejący, zgodny plik punktu kontrolnego jest wczytywany i obliczenia są wznawiane.
+    string checkpointFile;
+    int checkpointInterval = 1000;
+
+    // Zapis przebiegu zbieżności: plik CSV lub JSON (pusty - wyłączony) oraz co ile pokoleń
+    // zapisywany jest punkt przebiegu
+    string traceFile;
+    int traceInterval = 10;
+
+    // Koszt docelowy - obliczenia kończą się po znalezieniu trasy o koszcie nie większym (0 - brak)
+    long long targetCost = 0;
+
+    // Eliminacja duplikatów tras w sukcesji oraz pojemność pamięci kosztów tras (wpisy na wątek
+    // roboczy, 0 - wyłączona). Obie funkcje korzystają ze skrótów tras (TourHash)
+    bool rejectDuplicates = false;
+    int costCacheSize = 0;
+
+    // Heurystyka konstrukcyjna populacji początkowej (RANDOM, NN, GREEDY, INSERTION, MIX) oraz część
+    // populacji budowana heurystycznie - pozostałe trasy są losowe
+    string seedingMethod = "RANDOM";
+    double seedingRatio = 0.5;
+
+    // Dolne ograniczenie kosztu trasy (OFF, AP, HK) i liczba iteracji subgradientowych metody HK.
+    // Obliczenia kończą się, gdy najlepsza trasa jest najwyżej gapPercent % powyżej ograniczenia
+    // (0 - tylko po udowodnieniu optymalności)
+    string boundMethod = "OFF";
+    int boundIterations = 100;
+    double gapPercent = 0.0;
+
+    // Kryteria stopu wyspy: liczba pokoleń bez poprawy najlepszej trasy i limit pokoleń (0 - brak)
+    long long stagnationLimit = 0;
+    long long maxGenerations = 0;
+};
+
+// Wynik algorytmu genetycznego
+struct GAResult {
+    vector<int> bestTour;
+    int bestCost = 0;
+
+    // Czas obliczeń (wraz z czasem przebiegu wznowionego z punktu kontrolnego) i czas tego uruchomienia
+    double executionTime = 0.0;
+    double runTime = 0.0;
+
+    // Czas tworzenia populacji początkowej (niewliczany do czasu obliczeń)
+    double seedingTime = 0.0;
+
+    long long generations = 0;
+
+    // Liczba obliczeń kosztu w tym uruchomieniu
+    long long evaluations = 0;
+
+    // Liczba kosztów odczytanych z pamięci kosztów tras i liczba odrzuconych duplikatów
+    long long cacheHits = 0;
+    long long duplicatesRejected = 0;
+
+    uint64_t seed = 0;
+    bool resumed = false;
+
+    // Czy obliczenia zakończyły się po osiągnięciu kosztu docelowego
+    bool targetReached = false;
+
+    // Kryterium, które zakończyło obliczenia: TIME, TARGET, GAP, STAGNATION, GENERATIONS, CANCELLED
+    string stopReason = "TIME";
+
+    // Dolne ograniczenie kosztu trasy i czas jego obliczenia
+    bool lowerBoundComputed = false;
+    long long lowerBound = 0;
+    double boundTime = 0.0;
+
+    // Liczba alokacji pamięci w pętli głównej po pierwszym pokoleniu (-1 - nie mierzono)
+    long long steadyStateAllocations = -1;
+
+    // Szerokość genu i elementu macierzy odległości w bitach (typy wybrane dla instancji)
+    int geneBits = 0;
+    int distanceBits = 0;
+
+    // Postać danych odległości (DENSE, COORDINATES, SPARSE) i zajmowana przez nie pamięć
+    string distanceStorage;
+    size_t distanceBytes = 0;
+
+    // Liczba zapisanych i pominiętych punktów przebiegu zbieżności
+    long long tracePoints = 0;
+    long long traceDropped = 0;
+
+    // Pomiary etapów pokolenia zebrane ze wszystkich wysp (tylko przy GA_PROFILING)
+    Profiler profiler;
+
+    // Problemy, które nie przerwały obliczeń (np. nieudany zapis punktu kontrolnego) - wypisuje je
+    // wiersz poleceń i menu, a nie ATSP::solve
+    vector<string> warnings;
+
+    double generationsPerSecond() const {
+        return executionTime > 0.0 ? generations / executionTime : 0.0;
+    }
+
+    double evaluationsPerSecond() const {
+        return runTime > 0.0 ? evaluations / runTime : 0.0;
+    }
+
+    // Luka najlepszej trasy względem dolnego ograniczenia w procentach
+    double gapPercent() const {
+        return lowerBoundComputed && lowerBound != 0 ? 100.0 * (bestCost - lowerBound) / llabs(lowerBound) : 0.0;
+    }
+};
+
 class ATSP {
+    // Testy wydajności operatorów (benchmarks/Benchmark.cpp) korzystają z metod prywatnych
+    friend class Benchmark;
+
+    // Wybór wariantu pokolenia na podstawie parametrów (ATSP.cpp)
+    friend struct GenerationDispatch;
+
 public:
     void initializeDistanceMatrix(const int& newDimension);
 
@@ -19,45 +181,140 @@ public:
 
     void printDistanceMatrix();
 
-    void loadATSPFile(const string& fileName);
+    bool loadATSPFile(const string& fileName, const DistanceOptions& options = DistanceOptions());
 
-    void geneticAlgorithm(const string& fileName,
-                          const string& crossingMethod,
+    bool loadMatrix(int newDimension, const vector<int>& distances);
+
+    bool loadCoordinates(vector<double> x, vector<double> y, CoordinateMetric metric);
+
+    // Opis błędu ostatniego nieudanego wczytania instancji - metody wczytujące nie wypisują
+    // komunikatów, robią to wiersz poleceń i menu
+    const string& loadError() const {
+        return instanceError;
+    }
+
+    int dimension() const {
+        return V;
+    }
+
+    void geneticAlgorithm(const string& crossingMethod,
                           const string& maxExecutionTimeFactor,
                           const string& populationSizeFactor,
                           const string& crossoverRateFactor,
-                          const string& mutationRateFactor);
+                          const string& mutationRateFactor,
+                          const string& seedFactor,
+                          const string& threadCountFactor,
+                          const string& islandCountFactor,
+                          const string& migrationIntervalFactor,
+                          const string& migrantCountFactor,
+                          const string& migrationTopology,
+                          const string& selectionMethod,
+                          const string& tournamentSizeFactor,
+                          const string& successionPolicy,
+                          const string& replacementCountFactor,
+                          const string& localSearchMode,
+                          const string& checkpointFile,
+                          const string& checkpointIntervalFactor,
+                          const string& traceFile,
+                          const string& traceIntervalFactor);
+
+    static GAParameters parseParameters(const string& crossingMethod,
+                                        const string& maxExecutionTimeFactor,
+                                        const string& populationSizeFactor,
+                                        const string& crossoverRateFactor,
+                                        const string& mutationRateFactor,
+                                        const string& seedFactor,
+                                        const string& threadCountFactor,
+                                        const string& islandCountFactor,
+                                        const string& migrationIntervalFactor,
+                                        const string& migrantCountFactor,
+                                        const string& migrationTopology,
+                                        const string& selectionMethod,
+                                        const string& tournamentSizeFactor,
+                                        const string& successionPolicy,
+                                        const string& replacementCountFactor,
+                                        const string& localSearchMode,
+                                        const string& checkpointFile,
+                                        const string& checkpointIntervalFactor,
+                                        const string& traceFile,
+                                        const string& traceIntervalFactor);
+
+    // Sprawdzenie nazw metod i strategii w parametrach (false - nieznana nazwa opisana w error)
+    static bool checkParameterNames(const GAParameters& parameters, string& error);
+
+    // Sprawdzenie nazw oraz wartości liczbowych parametrów przed uruchomieniem obliczeń (false - błąd
+    // opisany w error). Wspólne dla wiersza poleceń, menu interaktywnego i interfejsu Solver
+    static bool checkParameters(const GAParameters& parameters, string& error);
+
+    // Opcjonalne sterowanie przebiegiem (anulowanie, publikacja najlepszej trasy, wywołanie zwrotne)
+    GAResult solve(GAParameters parameters, const SolveControl* control = nullptr);
+
+    static void printResult(const GAParameters& parameters, const GAResult& result);
 
 private:
     // Zmienna określająca rozmiar problemu (liczbę miast)
-    int V;
+    int V = 0;
+
+    // Odległości między miastami - pełna macierz (ciągły, wyrównany bufor), współrzędne
+    // albo rzadki zbiór łuków
+    DistanceProvider distanceProvider;
+
+    // Wsadowy ewaluator kosztu tras (jądro wybrane na podstawie możliwości procesora)
+    CostEvaluator costEvaluator;
+
+    // Listy najbliższych sąsiadów miast używane przez przeszukiwanie lokalne
+    CandidateLists candidateLists;
+
+    // Klucze skrótów tras (przygotowywane tylko przy eliminacji duplikatów lub pamięci kosztów)
+    TourHash tourHash;
+
+    string instanceError;
+
+    bool readInstanceFile(const string& fileName, const DistanceOptions& options);
+
+    bool checkTourCostRange();
+
+    bool acceptLoadedInstance();
+
+    void initializeIsland(Island& island, int islandIndex, const GAParameters& parameters, ThreadPool& pool);
+
+    // Pokolenie algorytmu skonkretyzowane dla wybranych operatorów i (opcjonalnie) rozmiaru problemu
+    using GenerationStep = void (ATSP::*)(Island& island, const GAParameters& parameters, ThreadPool& pool);
+
+    GenerationStep generationStep(const GAParameters& parameters) const;
+
+    template<typename Gene, typename Distances, typename Crossover, typename Mutation, typename SelectionPolicy,
+            typename SuccessionPolicy, int FixedDimension>
+    void evolveGeneration(Island& island, const GAParameters& parameters, ThreadPool& pool);
 
-    // Macierz przechowująca odległości między miastami
-    vector<vector<int>> distanceMatrix;
+    void migrate(vector<unique_ptr<Island>>& islands, int sourceIndex, const GAParameters& parameters);
 
-    void generateRandomChromosome(vector<int>& chromosome);
+    void acceptMigrants(Island& island);
 
-    void sortByCost(vector<vector<int>> &population);
+    void updateBestIndividual(Island& island);
 
-    int calculateCost(const vector<int>& chromosome);
+    template<typename Gene>
+    void generateRandomChromosome(Gene* chromosome, Random& random);
 
-    int rouletteWheel(const vector<double> &probabilities);
+    int calculateCost(const int* chromosome);
 
-    vector<int> crossoverOX(const vector<int>& parent1, const vector<int>& parent2);
+    void evaluate(PopulationArena& arena, int slot);
 
-    vector<int> crossoverPMX(const vector<int> &parent1, const vector<int> &parent2);
+    template<typename Gene, typename Distances>
+    int evaluateHashed(const Distances& distances, PopulationArena& arena, const int* slots, int count,
+                       CostCache& cache, long long& hits);
 
-    void insertionMutation(vector<int> &chromosome);
+    template<typename Gene, typename Distances>
+    void improveIndividual(const Distances& distances, PopulationArena& arena, int slot, LocalSearch& localSearch);
 
-    void succession(vector<vector<int>> &currentPopulation,
-                    const vector<vector<int>> &parents,
-                    const vector<vector<int>> &offspring);
+    void crossoverOX(const int* parent1, const int* parent2, int* child, CrossoverScratch& scratch, Random& random);
 
-    static int generateRandomInteger(int min, int max);
+    void crossoverPMX(const int* parent1, const int* parent2, int* child1, int* child2,
+                      CrossoverScratch& scratch, Random& random);
 
-    static double generateRandomDouble(double min, double max);
+    void insertionMutation(PopulationArena& arena, int slot, Random& random);
 
-    static long long int read_QPC();
+    void swapMutation(PopulationArena& arena, int slot, Random& random);
 };
 
 
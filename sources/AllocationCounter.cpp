@@ -0,0 +1,136 @@
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+using namespace std;
+
+#ifdef GA_ALLOCATION_COUNTING
+
+namespace {
+
+thread_local long long allocationCount = 0;
+
+// Przydział z obsługą new_handler (jak w standardowym operatorze new): po nieudanej próbie
+// wywoływana jest zainstalowana funkcja obsługi, a bez niej zgłaszany jest bad_alloc
+template<typename Allocate>
+void* allocateWithHandler(Allocate allocate) {
+    while (true) {
+        void* pointer = allocate();
+        if (pointer != nullptr) {
+            return pointer;
+        }
+        new_handler handler = get_new_handler();
+        if (handler == nullptr) {
+            throw bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* countedAllocate(size_t size) {
+    allocationCount++;
+    return allocateWithHandler([size]() {
+        return malloc(size == 0 ? 1 : size);
+    });
+}
+
+void* countedAlignedAllocate(size_t size, size_t alignment) {
+    allocationCount++;
+
+    // Rozmiar musi być wielokrotnością wyrównania (wymaganie aligned_alloc)
+    size = (size + alignment - 1) / alignment * alignment;
+    return allocateWithHandler([size, alignment]() {
+#ifdef _WIN32
+        return _aligned_malloc(size == 0 ? alignment : size, alignment);
+#else
+        return aligned_alloc(alignment, size == 0 ? alignment : size);
+#endif
+    });
+}
+
+void alignedFree(void* pointer) {
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    free(pointer);
+#endif
+}
+
+}
+
+long long AllocationCounter::threadAllocations() {
+    return allocationCount;
+}
+
+void* operator new(size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(size_t size, align_val_t alignment) {
+    return countedAlignedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, align_val_t alignment) {
+    return countedAlignedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete[](void* pointer, align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t, align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t, align_val_t) noexcept {
+    alignedFree(pointer);
+}
+
+#else
+
+long long AllocationCounter::threadAllocations() {
+    return 0;
+}
+
+#endif
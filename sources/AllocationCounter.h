@@ -0,0 +1,25 @@
+#ifndef GENETIC_ALGORITHM_ALLOCATIONCOUNTER_H
+#define GENETIC_ALGORITHM_ALLOCATIONCOUNTER_H
+
+
+// Licznik alokacji pamięci na stercie. Przy GA_ALLOCATION_COUNTING (np. -DGA_ALLOCATION_COUNTING)
+// globalne operatory new/delete zastąpione są w pliku AllocationCounter.cpp wersjami zliczającymi
+// każde wywołanie, co pozwala sprawdzić, że pętla główna algorytmu nie alokuje pamięci w stanie
+// ustalonym. Bez tego makra operatory programu (także programu osadzającego algorytm) pozostają
+// bez zmian, a pomiar jest niedostępny. Liczniki są lokalne dla wątków - zliczanie nie współdzieli
+// linii pamięci podręcznej między wątkami, a pomiar przebiegu obejmuje tylko jego wątki, nawet gdy
+// w procesie działa wiele przebiegów naraz (partia zadań).
+class AllocationCounter {
+public:
+#ifdef GA_ALLOCATION_COUNTING
+    static constexpr bool Enabled = true;
+#else
+    static constexpr bool Enabled = false;
+#endif
+
+    // Liczba alokacji wykonanych przez bieżący wątek (0 bez GA_ALLOCATION_COUNTING)
+    static long long threadAllocations();
+};
+
+
+#endif //GENETIC_ALGORITHM_ALLOCATIONCOUNTER_H
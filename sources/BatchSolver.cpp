@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <numeric>
+
+#include "BatchSolver.h"
+
+BatchSolver::BatchSolver(int workerCount, const DistanceOptions& options)
+        : workerCount(workerCount < 1 ? 1 : workerCount), distanceOptions(options) {}
+
+void BatchSolver::setSplitting(int minimumDimension, int parts) {
+    splitDimension = max(0, minimumDimension);
+    splitParts = max(1, parts);
+}
+
+void BatchSolver::addInstance(const string& name, const ATSP& atsp) {
+    unique_ptr<Instance>& instance = instances[name];
+    instance = make_unique<Instance>();
+    instance->atsp = atsp;
+    instance->preloaded = true;
+    instance->loaded = true;
+}
+
+size_t BatchSolver::add(const string& instance, const GAParameters& parameters) {
+    if (instances.count(instance) == 0) {
+        instances.emplace(instance, make_unique<Instance>());
+    }
+
+    BatchJobResult job;
+    job.instance = instance;
+    job.parameters = parameters;
+    jobs.push_back(std::move(job));
+    states.push_back(make_unique<JobState>());
+    return jobs.size() - 1;
+}
+
+BatchSummary BatchSolver::run(const ProgressCallback& progress) {
+    progressCallback = progress;
+
+    // Zadania większych (znanych już) instancji zlecane są najpierw - krótkie zadania na końcu
+    // partii wyrównują obciążenie wątków
+    vector<size_t> order(jobs.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return instances.at(jobs[a].instance)->atsp.dimension() > instances.at(jobs[b].instance)->atsp.dimension();
+    });
+
+    BatchSummary summary;
+    summary.workers = workerCount;
+    summary.jobs = jobs.size();
+
+    timer.restart();
+    {
+        WorkStealingPool pool(workerCount);
+        for (size_t index : order) {
+            pool.submit([this, &pool, index](int) {
+                runJob(pool, index);
+            });
+        }
+        pool.wait();
+        summary.steals = pool.steals();
+    }
+    summary.wallTime = timer.elapsedSeconds();
+
+    for (const auto& entry : instances) {
+        summary.instancesLoaded += entry.second->loaded ? 1 : 0;
+    }
+    for (const BatchJobResult& job : jobs) {
+        if (!job.solved) {
+            summary.failedJobs++;
+            continue;
+        }
+        summary.generations += job.generations;
+        summary.evaluations += job.evaluations;
+        summary.busyTime += job.busyTime;
+    }
+    return summary;
+}
+
+// Instancja zadania wczytywana przy pierwszym użyciu (pozostałe zadania czekają na jej wczytanie)
+BatchSolver::Instance& BatchSolver::instanceFor(const string& name) {
+    Instance& instance = *instances.at(name);
+    if (!instance.preloaded) {
+        call_once(instance.loading, [&]() {
+            instance.loaded = instance.atsp.loadATSPFile(name, distanceOptions);
+        });
+    }
+    return instance;
+}
+
+void BatchSolver::runJob(WorkStealingPool& pool, size_t index) {
+    BatchJobResult& job = jobs[index];
+    JobState& state = *states[index];
+    job.startTime = timer.elapsedSeconds();
+
+    const Instance& instance = instanceFor(job.instance);
+    if (!instance.loaded) {
+        job.finishTime = timer.elapsedSeconds();
+        finishJob(index);
+        return;
+    }
+
+    const bool splittable = job.parameters.checkpointFile.empty() && job.parameters.traceFile.empty();
+    job.parts = splitDimension > 0 && splittable && instance.atsp.dimension() >= splitDimension ? splitParts : 1;
+    state.partResults.resize(job.parts);
+    state.partTimes.resize(job.parts);
+    state.remainingParts.store(job.parts);
+
+    // Części 1..parts-1 trafiają do kolejki tego wątku (bezczynne wątki je podkradają),
+    // a część 0 wykonywana jest od razu
+    for (int part = job.parts - 1; part >= 1; part--) {
+        pool.submit([this, index, part](int) {
+            runPart(index, part);
+        });
+    }
+    runPart(index, 0);
+}
+
+void BatchSolver::runPart(size_t index, int part) {
+    BatchJobResult& job = jobs[index];
+    JobState& state = *states[index];
+
+    // Kopia ATSP współdzieli odległości instancji - własne są tylko dane przebiegu
+    ATSP atsp = instances.at(job.instance)->atsp;
+    GAParameters parameters = job.parameters;
+    parameters.seed += part;
+    parameters.threadCount = max(1, parameters.threadCount / job.parts);
+    Timer partTimer;
+    state.partResults[part] = atsp.solve(parameters);
+    state.partTimes[part] = partTimer.elapsedSeconds();
+
+    if (state.remainingParts.fetch_sub(1) == 1) {
+        job.finishTime = timer.elapsedSeconds();
+        job.solved = true;
+        finishJob(index);
+    }
+}
+
+// Połączenie wyników części (najlepszy przebieg oraz sumy pokoleń i obliczeń) i zgłoszenie postępu
+void BatchSolver::finishJob(size_t index) {
+    BatchJobResult& job = jobs[index];
+    JobState& state = *states[index];
+
+    if (job.solved) {
+        size_t best = 0;
+        for (size_t part = 1; part < state.partResults.size(); part++) {
+            if (state.partResults[part].bestCost < state.partResults[best].bestCost) {
+                best = part;
+            }
+        }
+        for (const GAResult& partResult : state.partResults) {
+            job.generations += partResult.generations;
+            job.evaluations += partResult.evaluations;
+        }
+        job.result = std::move(state.partResults[best]);
+        for (double partTime : state.partTimes) {
+            job.busyTime += partTime;
+        }
+        state.partResults.clear();
+    }
+
+    if (progressCallback) {
+        lock_guard<mutex> lock(progressMutex);
+        progressCallback(index, job);
+    }
+}
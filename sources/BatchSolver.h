@@ -0,0 +1,151 @@
+#ifndef GENETIC_ALGORITHM_BATCHSOLVER_H
+#define GENETIC_ALGORITHM_BATCHSOLVER_H
+
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ATSP.h"
+#include "Timer.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+// Wynik zadania partii wraz z pomiarami przepustowości
+struct BatchJobResult {
+    string instance;
+    GAParameters parameters;
+    GAResult result;
+
+    // Czy instancję udało się wczytać (false - zadanie pominięte)
+    bool solved = false;
+
+    // Liczba części, na które podzielono zadanie (1 - bez podziału)
+    int parts = 1;
+
+    // Suma pokoleń i obliczeń kosztu wszystkich części (result zawiera liczby najlepszej części,
+    // zgodne z jej czasem wykonania)
+    long long generations = 0;
+    long long evaluations = 0;
+
+    // Czas rozpoczęcia i zakończenia zadania liczony od rozpoczęcia partii
+    double startTime = 0.0;
+    double finishTime = 0.0;
+
+    // Suma czasów wykonania części zadania (bez podziału - czas zadania)
+    double busyTime = 0.0;
+
+    double wallTime() const {
+        return finishTime - startTime;
+    }
+
+    double evaluationsPerSecond() const {
+        return wallTime() > 0.0 ? evaluations / wallTime() : 0.0;
+    }
+};
+
+// Podsumowanie całej partii
+struct BatchSummary {
+    int workers = 0;
+    size_t jobs = 0;
+    size_t failedJobs = 0;
+    size_t instancesLoaded = 0;
+    long long steals = 0;
+    double wallTime = 0.0;
+
+    // Suma czasów zadań (przy pełnym wykorzystaniu wątków - wallTime * workers)
+    double busyTime = 0.0;
+
+    long long generations = 0;
+    long long evaluations = 0;
+
+    double jobsPerSecond() const {
+        return wallTime > 0.0 ? jobs / wallTime : 0.0;
+    }
+
+    double evaluationsPerSecond() const {
+        return wallTime > 0.0 ? evaluations / wallTime : 0.0;
+    }
+
+    // Wykorzystanie wątków puli (0 - 1)
+    double utilization() const {
+        return wallTime > 0.0 && workers > 0 ? busyTime / (wallTime * workers) : 0.0;
+    }
+};
+
+// Rozwiązywanie partii wielu zadań (instancja, parametry) na wspólnej puli z podkradaniem zadań.
+// Każda instancja wczytywana jest raz, a zadania pracują na kopiach ATSP współdzielących odległości.
+// Małe instancje rozwiązywane są jednym przebiegiem na wątek. Zadanie dla instancji o co najmniej
+// splitDimension miastach wykonywane jest wielostartowo: splitParts niezależnych przebiegów (ziarna
+// seed, seed + 1, ...) z pełnym limitem czasu, które bezczynne wątki podkradają z kolejki wątku
+// zadania. Wątki algorytmu (threadCount) dzielone są między części, aby nie przekraczać liczby wątków
+// zadania. Wynikiem jest najlepszy przebieg (wraz z jego ziarnem i liczbami pokoleń), a sumy pokoleń
+// i obliczeń kosztu wszystkich części podawane są osobno. Zadania z punktem kontrolnym lub zapisem
+// przebiegu zbieżności nie są dzielone (części nadpisywałyby swoje pliki).
+class BatchSolver {
+public:
+    using ProgressCallback = function<void(size_t index, const BatchJobResult& job)>;
+
+    explicit BatchSolver(int workerCount, const DistanceOptions& options = DistanceOptions());
+
+    // Podział zadań dużych instancji (minimumDimension = 0 - bez podziału)
+    void setSplitting(int minimumDimension, int parts);
+
+    // Instancja wczytana wcześniej (zadania o tej nazwie nie wczytują jej ponownie)
+    void addInstance(const string& name, const ATSP& atsp);
+
+    // Dodanie zadania - zwracany jest jego numer w wynikach
+    size_t add(const string& instance, const GAParameters& parameters);
+
+    // Wykonanie wszystkich zadań (progress wywoływane po każdym zadaniu, szeregowo)
+    BatchSummary run(const ProgressCallback& progress = nullptr);
+
+    const vector<BatchJobResult>& results() const {
+        return jobs;
+    }
+
+private:
+    // Instancja przekazana przez addInstance albo wczytywana raz przez pierwsze zadanie
+    struct Instance {
+        once_flag loading;
+        bool preloaded = false;
+        bool loaded = false;
+        ATSP atsp;
+    };
+
+    // Stan zadania w trakcie wykonywania (wyniki części łączone po zakończeniu ostatniej)
+    struct JobState {
+        vector<GAResult> partResults;
+        vector<double> partTimes;
+        atomic<int> remainingParts{0};
+    };
+
+    int workerCount;
+    DistanceOptions distanceOptions;
+    int splitDimension = 0;
+    int splitParts = 1;
+
+    map<string, unique_ptr<Instance>> instances;
+    vector<BatchJobResult> jobs;
+    vector<unique_ptr<JobState>> states;
+
+    Timer timer;
+    mutex progressMutex;
+    ProgressCallback progressCallback;
+
+    Instance& instanceFor(const string& name);
+
+    void runJob(WorkStealingPool& pool, size_t index);
+
+    void runPart(size_t index, int part);
+
+    void finishJob(size_t index);
+};
+
+
+#endif //GENETIC_ALGORITHM_BATCHSOLVER_H
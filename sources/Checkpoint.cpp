@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "Checkpoint.h"
+
+namespace {
+
+    const char Magic[8] = {'G', 'A', 'C', 'H', 'K', 'P', 'T', '\0'};
+
+    // Nagłówek pliku punktu kontrolnego
+    struct CheckpointHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t islandCount;
+        uint32_t dimension;
+        uint32_t populationSize;
+        uint32_t randomsPerIsland;
+        uint32_t reserved;
+        uint64_t fingerprint;
+        uint64_t seed;
+        double elapsedTime;
+    };
+
+    template<typename T>
+    void writeValues(ofstream& file, const T* values, size_t count) {
+        file.write(reinterpret_cast<const char*>(values), static_cast<streamsize>(count * sizeof(T)));
+    }
+
+    template<typename T>
+    bool readValues(ifstream& file, T* values, size_t count) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(values), static_cast<streamsize>(count * sizeof(T))));
+    }
+}
+
+// Odcisk danych odległości (FNV-1a), który wiąże punkt kontrolny z instancją. Dla pełnej macierzy
+// liczony z wartości odległości, więc nie zależy od szerokości elementów macierzy; dla współrzędnych
+// i łuków rzadkich - z przechowywanych danych (bez liczenia V * V odległości)
+uint64_t Checkpoint::distanceFingerprint(const DistanceProvider& distances) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value) {
+        for (int byte = 0; byte < 8; byte++) {
+            hash = (hash ^ ((value >> (8 * byte)) & 0xFF)) * 1099511628211ULL;
+        }
+    };
+    const int V = distances.dimension();
+
+    if (distances.storage() == DistanceProvider::Storage::Coordinates) {
+        const CoordinateDistances coordinates = distances.coordinates();
+        mix(static_cast<uint64_t>(coordinates.metric));
+        for (int city = 0; city < V; city++) {
+            uint64_t x, y;
+            memcpy(&x, &coordinates.x[city], sizeof(x));
+            memcpy(&y, &coordinates.y[city], sizeof(y));
+            mix(x);
+            mix(y);
+        }
+        return hash;
+    }
+
+    if (distances.storage() == DistanceProvider::Storage::Sparse) {
+        const SparseDistances sparse = distances.sparse();
+        mix(static_cast<uint32_t>(sparse.penalty));
+        for (int from = 0; from < V; from++) {
+            for (int i = sparse.offsets[from]; i < sparse.offsets[from + 1]; i++) {
+                mix((static_cast<uint64_t>(from) << 32) | static_cast<uint32_t>(sparse.targets[i]));
+                mix(static_cast<uint32_t>(sparse.weights[i]));
+            }
+        }
+        return hash;
+    }
+
+    const DistanceMatrix& matrix = distances.matrix();
+    for (int from = 0; from < V; from++) {
+        for (int to = 0; to < V; to++) {
+            hash = (hash ^ static_cast<uint32_t>(matrix(from, to))) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+void Checkpoint::prepare(const DistanceProvider& distances, uint64_t seed, int islandCount, int newPopulationSize,
+                         int newRandomsPerIsland) {
+    this->distances = &distances;
+    fingerprint = distanceFingerprint(distances);
+    randomSeed = seed;
+    dimension = distances.dimension();
+    populationSize = newPopulationSize;
+    randomsPerIsland = newRandomsPerIsland;
+    previousElapsedTime = 0.0;
+
+    islands.assign(islandCount, IslandSnapshot());
+    for (IslandSnapshot& snapshot : islands) {
+        snapshot.genes.assign(static_cast<size_t>(populationSize) * dimension, 0);
+        snapshot.costs.assign(populationSize, 0);
+        snapshot.bestTour.assign(dimension, 0);
+        snapshot.randomStates.assign(randomsPerIsland, array<uint64_t, 4>());
+    }
+}
+
+void Checkpoint::capture(const Island& island, int islandIndex) {
+    lock_guard<mutex> lock(snapshotMutex);
+
+    IslandSnapshot& snapshot = islands[islandIndex];
+    const PopulationArena& arena = island.arena;
+
+    snapshot.generation = island.generation;
+    for (int i = 0; i < populationSize; i++) {
+        const int slot = arena.currentSlot(i);
+        arena.readGenes(slot, snapshot.genes.data() + static_cast<size_t>(i) * dimension);
+        snapshot.costs[i] = arena.cost(slot);
+    }
+    copy(island.bestIndividual.chromosome.begin(), island.bestIndividual.chromosome.end(), snapshot.bestTour.begin());
+    snapshot.bestCost = island.bestIndividual.cost;
+    for (int worker = 0; worker < randomsPerIsland; worker++) {
+        snapshot.randomStates[worker] = island.randoms[worker].state();
+    }
+}
+
+void Checkpoint::restore(Island& island, int islandIndex) const {
+    const IslandSnapshot& snapshot = islands[islandIndex];
+    PopulationArena& arena = island.arena;
+
+    island.generation = snapshot.generation;
+    for (int i = 0; i < populationSize; i++) {
+        const int slot = arena.currentSlot(i);
+        arena.writeGenes(slot, snapshot.genes.data() + static_cast<size_t>(i) * dimension);
+        arena.cost(slot) = snapshot.costs[i];
+        arena.setDirty(slot, false);
+    }
+    copy(snapshot.bestTour.begin(), snapshot.bestTour.end(), island.bestIndividual.chromosome.begin());
+    island.bestIndividual.cost = snapshot.bestCost;
+    island.bestIndividual.dirty = false;
+    for (int worker = 0; worker < randomsPerIsland; worker++) {
+        island.randoms[worker].setState(snapshot.randomStates[worker]);
+    }
+}
+
+bool Checkpoint::save(const string& fileName, double elapsedTime) {
+    lock_guard<mutex> lock(snapshotMutex);
+
+    CheckpointHeader header{};
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.islandCount = static_cast<uint32_t>(islands.size());
+    header.dimension = static_cast<uint32_t>(dimension);
+    header.populationSize = static_cast<uint32_t>(populationSize);
+    header.randomsPerIsland = static_cast<uint32_t>(randomsPerIsland);
+    header.fingerprint = fingerprint;
+    header.seed = randomSeed;
+    header.elapsedTime = elapsedTime;
+
+    // Zapis do pliku tymczasowego i podmiana - przerwanie zapisu nie niszczy poprzedniego punktu kontrolnego
+    const string temporaryFileName = fileName + ".tmp";
+    {
+        ofstream file(temporaryFileName, ios::binary | ios::trunc);
+        if (!file) {
+            return false;
+        }
+        writeValues(file, &header, 1);
+        for (const IslandSnapshot& snapshot : islands) {
+            writeValues(file, &snapshot.generation, 1);
+            writeValues(file, &snapshot.bestCost, 1);
+            writeValues(file, snapshot.bestTour.data(), snapshot.bestTour.size());
+            writeValues(file, snapshot.randomStates.data(), snapshot.randomStates.size());
+            writeValues(file, snapshot.costs.data(), snapshot.costs.size());
+            writeValues(file, snapshot.genes.data(), snapshot.genes.size());
+        }
+        if (!file) {
+            return false;
+        }
+    }
+
+    error_code error;
+    filesystem::rename(temporaryFileName, fileName, error);
+    return !error;
+}
+
+bool Checkpoint::load(const string& fileName, string& error) {
+    ifstream file(fileName, ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    CheckpointHeader header{};
+    if (!readValues(file, &header, 1) ||
+        memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+        header.version != Version ||
+        header.islandCount != islands.size() ||
+        header.dimension != static_cast<uint32_t>(dimension) ||
+        header.populationSize != static_cast<uint32_t>(populationSize) ||
+        header.randomsPerIsland != static_cast<uint32_t>(randomsPerIsland) ||
+        header.fingerprint != fingerprint) {
+        return false;
+    }
+
+    // Wczytanie do kopii roboczych, aby niepełny plik nie zmienił przygotowanych migawek
+    vector<IslandSnapshot> loaded = islands;
+    for (IslandSnapshot& snapshot : loaded) {
+        if (!readValues(file, &snapshot.generation, 1) ||
+            !readValues(file, &snapshot.bestCost, 1) ||
+            !readValues(file, snapshot.bestTour.data(), snapshot.bestTour.size()) ||
+            !readValues(file, snapshot.randomStates.data(), snapshot.randomStates.size()) ||
+            !readValues(file, snapshot.costs.data(), snapshot.costs.size()) ||
+            !readValues(file, snapshot.genes.data(), snapshot.genes.size())) {
+            return false;
+        }
+    }
+
+    // Trasy trafiają bez sprawdzania zakresu do odczytów odległości - uszkodzony plik jest odrzucany
+    vector<char> visited(dimension);
+    for (const IslandSnapshot& snapshot : loaded) {
+        bool valid = validTour(snapshot.bestTour.data(), snapshot.bestCost, visited);
+        for (int i = 0; valid && i < populationSize; i++) {
+            valid = validTour(snapshot.genes.data() + static_cast<size_t>(i) * dimension, snapshot.costs[i], visited);
+        }
+        if (!valid) {
+            error = "invalid tours in the checkpoint " + fileName + ", starting from scratch";
+            return false;
+        }
+    }
+
+    lock_guard<mutex> lock(snapshotMutex);
+    islands = std::move(loaded);
+    randomSeed = header.seed;
+    previousElapsedTime = header.elapsedTime;
+    return true;
+}
+
+// Sprawdzenie, czy trasa jest permutacją miast 0..V-1 o zapisanym koszcie
+bool Checkpoint::validTour(const int* tour, int cost, vector<char>& visited) const {
+    fill(visited.begin(), visited.end(), 0);
+    for (int i = 0; i < dimension; i++) {
+        if (tour[i] < 0 || tour[i] >= dimension || visited[tour[i]]) {
+            return false;
+        }
+        visited[tour[i]] = 1;
+    }
+
+    const long long tourCost = distances->visit([&](const auto& view) {
+        long long sum = 0;
+        for (int i = 0; i < dimension; i++) {
+            sum += view(tour[i], tour[(i + 1) % dimension]);
+        }
+        return sum;
+    });
+    return tourCost == cost;
+}
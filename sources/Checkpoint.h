@@ -0,0 +1,82 @@
+#ifndef GENETIC_ALGORITHM_CHECKPOINT_H
+#define GENETIC_ALGORITHM_CHECKPOINT_H
+
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "DistanceProvider.h"
+#include "Island.h"
+
+using namespace std;
+
+// Zapisany stan jednej wyspy: populacja (w kolejności listy populacji) wraz z kosztami,
+// najlepsza trasa, stany generatorów liczb losowych oraz liczba wykonanych pokoleń
+struct IslandSnapshot {
+    long long generation = 0;
+    vector<int> genes;
+    vector<int> costs;
+    vector<int> bestTour;
+    int bestCost = 0;
+    vector<array<uint64_t, 4>> randomStates;
+};
+
+// Punkt kontrolny algorytmu genetycznego - okresowo zapisywany stan wszystkich wysp,
+// z którego można wznowić przerwane obliczenia. Plik zawiera odcisk danych odległości
+// i rozmiary populacji, więc nie da się go użyć z inną instancją lub konfiguracją.
+class Checkpoint {
+public:
+    static constexpr uint32_t Version = 1;
+
+    // Przygotowanie buforów dla islandCount wysp (jednorazowa alokacja)
+    void prepare(const DistanceProvider& distances, uint64_t seed, int islandCount, int populationSize,
+                 int randomsPerIsland);
+
+    // Skopiowanie stanu wyspy do punktu kontrolnego (bezpieczne dla wielu wątków)
+    void capture(const Island& island, int islandIndex);
+
+    // Odtworzenie stanu wyspy z punktu kontrolnego (wyspa musi być już zainicjalizowana)
+    void restore(Island& island, int islandIndex) const;
+
+    // Zapis do pliku (przez plik tymczasowy) wraz z dotychczasowym czasem obliczeń
+    bool save(const string& fileName, double elapsedTime);
+
+    // Wczytanie punktu kontrolnego zgodnego z konfiguracją ustaloną w prepare. Plik, w którym trasa
+    // nie jest permutacją miast lub zapisany koszt nie zgadza się z obliczonym, jest odrzucany
+    // (z opisem w error - brak pliku lub plik innej konfiguracji nie jest błędem)
+    bool load(const string& fileName, string& error);
+
+    uint64_t seed() const {
+        return randomSeed;
+    }
+
+    double elapsedTime() const {
+        return previousElapsedTime;
+    }
+
+private:
+    uint64_t fingerprint = 0;
+    uint64_t randomSeed = 0;
+    int dimension = 0;
+    int populationSize = 0;
+    int randomsPerIsland = 0;
+    double previousElapsedTime = 0.0;
+
+    vector<IslandSnapshot> islands;
+
+    // Odległości instancji (do sprawdzenia tras wczytanego pliku)
+    const DistanceProvider* distances = nullptr;
+
+    // Blokada chroniąca migawki wysp podczas kopiowania i zapisu
+    mutex snapshotMutex;
+
+    static uint64_t distanceFingerprint(const DistanceProvider& distances);
+
+    bool validTour(const int* tour, int cost, vector<char>& visited) const;
+};
+
+
+#endif //GENETIC_ALGORITHM_CHECKPOINT_H
@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#include "CommandLine.h"
+#include "ATSP.h"
+#include "BatchSolver.h"
+#include "ThreadPool.h"
+#include "NumberParsing.h"
+
+namespace {
+
+    // Klucze parametrów algorytmu (w kolejności argumentów ATSP::parseParameters, a po nich
+    // parametry ustawiane bezpośrednio w GAParameters)
+    const vector<string> ParameterKeys = {
+            "method", "time", "population", "crossover", "mutation", "seed", "threads",
+            "islands", "migration-interval", "migrants", "topology", "selection", "tournament",
+            "succession", "replacement", "local-search", "checkpoint", "checkpoint-interval",
+            "trace", "trace-interval", "target", "unique", "cost-cache",
+            "seeding", "seeding-ratio", "bound", "bound-iterations", "gap", "stagnation", "generations",
+            "mutation-method"
+    };
+
+    // Klucze sterujące uruchomieniem
+    const vector<string> ControlKeys = {"instance", "sweep", "config", "output", "jobs", "split", "split-parts",
+                                        "distances", "matrix-memory", "sparse-neighbours", "sparse-penalty"};
+
+    // Wartości domyślne parametrów, które w menu trzeba podać jawnie
+    const map<string, string> Defaults = {
+            {"method",     "OX"},
+            {"time",       "10"},
+            {"population", "100"},
+            {"crossover",  "0.8"},
+            {"mutation",   "0.01"}
+    };
+
+    bool isKnownKey(const string& key) {
+        return find(ParameterKeys.begin(), ParameterKeys.end(), key) != ParameterKeys.end() ||
+               find(ControlKeys.begin(), ControlKeys.end(), key) != ControlKeys.end();
+    }
+
+    string trim(const string& text) {
+        const size_t first = text.find_first_not_of(" \t\r\n");
+        if (first == string::npos) {
+            return "";
+        }
+        const size_t last = text.find_last_not_of(" \t\r\n");
+        return text.substr(first, last - first + 1);
+    }
+
+    string jsonString(const string& text) {
+        string result = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+                result += c;
+            } else if (c == '\n') {
+                result += "\\n";
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                result += ' ';
+            } else {
+                result += c;
+            }
+        }
+        return result + "\"";
+    }
+
+    // Dodanie numeru przebiegu do nazwy pliku (przed rozszerzeniem), aby przebiegi siatki nie nadpisywały plików
+    string withRunIndex(const string& fileName, size_t index) {
+        filesystem::path path(fileName);
+        path.replace_filename(path.stem().string() + "-" + to_string(index) + path.extension().string());
+        return path.string();
+    }
+
+    // Jeden przebieg siatki parametrów
+    struct Run {
+        string instance;
+        map<string, string> options;
+        GAParameters parameters;
+        GAResult result;
+
+        // Liczba części przebiegu, jego czas w partii oraz sumy pokoleń i obliczeń kosztu
+        // wszystkich części (BatchSolver)
+        int parts = 1;
+        double wallTime = 0.0;
+        long long totalGenerations = 0;
+        long long totalEvaluations = 0;
+    };
+
+    void writeRun(ostream& output, const Run& run, const string& indent) {
+        const GAParameters& parameters = run.parameters;
+        const GAResult& result = run.result;
+
+        output << indent << "{\n";
+        output << indent << "  \"instance\": " << jsonString(run.instance) << ",\n";
+        output << indent << "  \"method\": " << jsonString(parameters.crossingMethod) << ",\n";
+        output << indent << "  \"time_limit\": " << parameters.maxExecutionTime << ",\n";
+        output << indent << "  \"population\": " << parameters.populationSize << ",\n";
+        output << indent << "  \"crossover_rate\": " << parameters.crossoverRate << ",\n";
+        output << indent << "  \"mutation_rate\": " << parameters.mutationRate << ",\n";
+        output << indent << "  \"mutation_method\": " << jsonString(parameters.mutationMethod) << ",\n";
+        output << indent << "  \"seed\": " << result.seed << ",\n";
+        output << indent << "  \"threads\": " << parameters.threadCount << ",\n";
+        output << indent << "  \"islands\": " << parameters.islandCount << ",\n";
+        output << indent << "  \"selection\": " << jsonString(parameters.selectionMethod) << ",\n";
+        output << indent << "  \"succession\": " << jsonString(parameters.successionPolicy) << ",\n";
+        output << indent << "  \"local_search\": " << jsonString(parameters.localSearchMode) << ",\n";
+        output << indent << "  \"gene_bits\": " << result.geneBits << ",\n";
+        output << indent << "  \"distance_bits\": " << result.distanceBits << ",\n";
+        output << indent << "  \"distance_storage\": " << jsonString(result.distanceStorage) << ",\n";
+        output << indent << "  \"distance_bytes\": " << result.distanceBytes << ",\n";
+        output << indent << "  \"resumed\": " << (result.resumed ? "true" : "false") << ",\n";
+        output << indent << "  \"best_cost\": " << result.bestCost << ",\n";
+        if (result.lowerBoundComputed) {
+            output << indent << "  \"lower_bound\": " << result.lowerBound << ",\n";
+            output << indent << "  \"gap_percent\": " << result.gapPercent() << ",\n";
+            output << indent << "  \"bound_time\": " << result.boundTime << ",\n";
+        }
+        output << indent << "  \"stop_reason\": " << jsonString(result.stopReason) << ",\n";
+        if (!result.warnings.empty()) {
+            output << indent << "  \"warnings\": [";
+            for (size_t i = 0; i < result.warnings.size(); i++) {
+                output << (i == 0 ? "" : ", ") << jsonString(result.warnings[i]);
+            }
+            output << "],\n";
+        }
+        if (parameters.targetCost > 0) {
+            output << indent << "  \"target_cost\": " << parameters.targetCost << ",\n";
+            output << indent << "  \"target_reached\": " << (result.targetReached ? "true" : "false") << ",\n";
+        }
+        output << indent << "  \"best_tour\": [";
+        for (size_t i = 0; i < result.bestTour.size(); i++) {
+            output << (i == 0 ? "" : ", ") << result.bestTour[i];
+        }
+        output << "],\n";
+        output << indent << "  \"execution_time\": " << result.executionTime << ",\n";
+        output << indent << "  \"wall_time\": " << run.wallTime << ",\n";
+        output << indent << "  \"parts\": " << run.parts << ",\n";
+        output << indent << "  \"total_generations\": " << run.totalGenerations << ",\n";
+        output << indent << "  \"total_evaluations\": " << run.totalEvaluations << ",\n";
+        output << indent << "  \"seeding\": " << jsonString(parameters.seedingMethod) << ",\n";
+        output << indent << "  \"seeding_ratio\": " << parameters.seedingRatio << ",\n";
+        output << indent << "  \"seeding_time\": " << result.seedingTime << ",\n";
+        output << indent << "  \"generations\": " << result.generations << ",\n";
+        output << indent << "  \"generations_per_second\": " << result.generationsPerSecond() << ",\n";
+        output << indent << "  \"evaluations\": " << result.evaluations << ",\n";
+        output << indent << "  \"evaluations_per_second\": " << result.evaluationsPerSecond() << ",\n";
+        output << indent << "  \"unique\": " << (parameters.rejectDuplicates ? "true" : "false") << ",\n";
+        output << indent << "  \"duplicates_rejected\": " << result.duplicatesRejected << ",\n";
+        output << indent << "  \"cost_cache\": " << parameters.costCacheSize << ",\n";
+        output << indent << "  \"cost_cache_hits\": " << result.cacheHits << "\n";
+        output << indent << "}";
+    }
+}
+
+void CommandLine::printUsage() {
+    cout << "Uzycie: ga [instancja] [--klucz wartosc ...]\n"
+            "  --instance plik[,plik...]   instancje TSPLIB (.atsp, .tsp)\n"
+            "  --sweep katalog             wszystkie instancje .atsp/.tsp z katalogu\n"
+            "  --config plik               plik konfiguracyjny (klucz = wartosc)\n"
+            "  --output plik               plik wynikow JSON (domyslnie standardowe wyjscie)\n"
+            "  --jobs n                    liczba rownoleglych przebiegow siatki\n"
+            "  --split V  --split-parts n  wielostart: n niezaleznych przebiegow instancji od V miast (domyslnie --jobs)\n"
+            "  --method OX|PMX  --time s  --population n  --crossover r  --mutation r\n"
+            "  --mutation-method INSERTION|SWAP  operator mutacji (domyslnie INSERTION)\n"
+            "  --seed n  --threads n  --islands n  --migration-interval n  --migrants n\n"
+            "  --topology RING|FULL|RANDOM  --selection RW|BS|ALIAS|TOUR  --tournament n\n"
+            "  --succession PARENTS|PLUS|COMMA|STEADY  --replacement n  --local-search OFF|BEST|ALL\n"
+            "  --checkpoint plik  --checkpoint-interval n  --trace plik  --trace-interval n\n"
+            "  --target koszt              zakonczenie po znalezieniu trasy o takim koszcie\n"
+            "  --unique ON|OFF             eliminacja duplikatow tras w sukcesji (domyslnie OFF)\n"
+            "  --cost-cache n              pamiec kosztow tras, wpisy na watek (domyslnie 0 - wylaczona)\n"
+            "  --seeding RANDOM|NN|GREEDY|INSERTION|MIX  heurystyka populacji poczatkowej (domyslnie RANDOM)\n"
+            "  --seeding-ratio r           czesc populacji budowana heurystyka (domyslnie 0.5)\n"
+            "  --bound OFF|AP|HK  --bound-iterations n  dolne ograniczenie kosztu (przydzial, 1-arborescencja)\n"
+            "  --gap p                     zakonczenie przy luce p% wzgledem ograniczenia (domyslnie 0)\n"
+            "  --stagnation n              zakonczenie po n pokoleniach bez poprawy\n"
+            "  --generations n             limit pokolen (na wyspe)\n"
+            "  --distances AUTO|DENSE|COORDINATES|SPARSE  postac odleglosci (domyslnie AUTO)\n"
+            "  --matrix-memory MB          limit pamieci pelnej macierzy dla AUTO (domyslnie 1024)\n"
+            "  --sparse-neighbours k  --sparse-penalty koszt  luki postaci rzadkiej i koszt pozostalych\n"
+            "Wartosci oddzielone przecinkami tworza siatke parametrow (np. --method OX,PMX).\n";
+}
+
+bool CommandLine::parseArguments(int argc, char* argv[], Options& options) {
+    Options flags;
+
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if (argument == "--help" || argument == "-h") {
+            return false;
+        }
+
+        // Argument pozycyjny - ścieżka instancji
+        if (argument.rfind("--", 0) != 0) {
+            flags["instance"] = flags["instance"].empty() ? argument : flags["instance"] + "," + argument;
+            continue;
+        }
+
+        string key = argument.substr(2);
+        string value;
+        const size_t equals = key.find('=');
+        if (equals != string::npos) {
+            value = key.substr(equals + 1);
+            key = key.substr(0, equals);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            cerr << "ERROR: missing value for --" << key << endl;
+            return false;
+        }
+
+        if (!isKnownKey(key)) {
+            cerr << "ERROR: unknown option --" << key << endl;
+            return false;
+        }
+        flags[key] = value;
+    }
+
+    // Plik konfiguracyjny jest wczytywany najpierw, a flagi nadpisują jego wartości
+    if (flags.count("config") != 0 && !parseConfigFile(flags["config"], options)) {
+        return false;
+    }
+    for (const auto& flag : flags) {
+        options[flag.first] = flag.second;
+    }
+    return true;
+}
+
+bool CommandLine::parseConfigFile(const string& fileName, Options& options) {
+    ifstream file(fileName);
+    if (!file.is_open()) {
+        cerr << "ERROR while opening the config file: " << fileName << endl;
+        return false;
+    }
+
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        const size_t separator = line.find_first_of("=:");
+        if (separator == string::npos) {
+            cerr << "ERROR in config file " << fileName << ":" << lineNumber << ": expected key = value" << endl;
+            return false;
+        }
+
+        const string key = trim(line.substr(0, separator));
+        if (!isKnownKey(key) || key == "config") {
+            cerr << "ERROR in config file " << fileName << ":" << lineNumber << ": unknown key " << key << endl;
+            return false;
+        }
+        options[key] = trim(line.substr(separator + 1));
+    }
+    return true;
+}
+
+vector<string> CommandLine::split(const string& value) {
+    vector<string> values;
+    stringstream stream(value);
+    string item;
+    while (getline(stream, item, ',')) {
+        values.push_back(trim(item));
+    }
+    if (values.empty()) {
+        values.emplace_back();
+    }
+    return values;
+}
+
+vector<string> CommandLine::instanceFiles(const Options& options) {
+    vector<string> files;
+
+    auto instance = options.find("instance");
+    if (instance != options.end() && !instance->second.empty()) {
+        files = split(instance->second);
+    }
+
+    auto sweep = options.find("sweep");
+    if (sweep != options.end() && !sweep->second.empty()) {
+        error_code error;
+        vector<string> directoryFiles;
+        for (const auto& entry : filesystem::directory_iterator(sweep->second, error)) {
+            const string extension = entry.path().extension().string();
+            if (entry.is_regular_file() && (extension == ".atsp" || extension == ".tsp")) {
+                directoryFiles.push_back(entry.path().string());
+            }
+        }
+        if (error) {
+            cerr << "ERROR while reading the directory: " << sweep->second << endl;
+        }
+        sort(directoryFiles.begin(), directoryFiles.end());
+        files.insert(files.end(), directoryFiles.begin(), directoryFiles.end());
+    }
+    return files;
+}
+
+// Iloczyn kartezjański wartości wszystkich parametrów algorytmu
+vector<CommandLine::Options> CommandLine::parameterGrid(const Options& options) {
+    vector<Options> grid(1);
+
+    for (const string& key : ParameterKeys) {
+        auto option = options.find(key);
+        string value = option != options.end() ? option->second : "";
+        if (value.empty() && Defaults.count(key) != 0) {
+            value = Defaults.at(key);
+        }
+
+        vector<Options> expanded;
+        for (const Options& combination : grid) {
+            for (const string& item : split(value)) {
+                expanded.push_back(combination);
+                expanded.back()[key] = item;
+            }
+        }
+        grid = std::move(expanded);
+    }
+    return grid;
+}
+
+int CommandLine::run(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    const vector<string> files = instanceFiles(options);
+    if (files.empty()) {
+        cerr << "ERROR: no instance given (--instance or --sweep)" << endl;
+        printUsage();
+        return 2;
+    }
+
+    // Postać danych odległości wspólna dla wszystkich instancji
+    DistanceOptions distanceOptions;
+    try {
+        if (!options["distances"].empty()) {
+            distanceOptions.storage = DistanceProvider::storageFromName(options["distances"]);
+            if (distanceOptions.storage == DistanceProvider::Storage::Auto && options["distances"] != "AUTO") {
+                cerr << "ERROR: unknown distance storage " << options["distances"] << endl;
+                return 2;
+            }
+        }
+        if (!options["matrix-memory"].empty()) {
+            distanceOptions.matrixMemoryLimit = static_cast<size_t>(parseUnsigned(options["matrix-memory"])) << 20;
+        }
+        if (!options["sparse-neighbours"].empty()) {
+            distanceOptions.sparseNeighbours = max(1, parseInt(options["sparse-neighbours"]));
+        }
+        if (!options["sparse-penalty"].empty()) {
+            distanceOptions.sparsePenalty = max(0, parseInt(options["sparse-penalty"]));
+        }
+    } catch (const exception&) {
+        cerr << "ERROR: invalid numeric parameter value" << endl;
+        return 2;
+    }
+
+    // Każda instancja wczytywana jest raz, a przebiegi pracują na kopiach
+    // (macierz z binarnej kopii instancji, współrzędne i łuki rzadkie są współdzielone bez kopiowania)
+    map<string, ATSP> instances;
+    for (const string& file : files) {
+        if (instances.count(file) != 0) {
+            continue;
+        }
+        ATSP atsp;
+        if (!atsp.loadATSPFile(file, distanceOptions)) {
+            cerr << "ERROR while loading the file: " << atsp.loadError() << endl;
+            cerr << "ERROR: skipping instance " << file << endl;
+            continue;
+        }
+        instances.emplace(file, std::move(atsp));
+    }
+    if (instances.empty()) {
+        return 1;
+    }
+
+    // Lista przebiegów: instancje x siatka parametrów
+    const vector<Options> grid = parameterGrid(options);
+    vector<Run> runs;
+    for (const string& file : files) {
+        if (instances.count(file) == 0) {
+            continue;
+        }
+        for (const Options& combination : grid) {
+            Run run;
+            run.instance = file;
+            run.options = combination;
+            runs.push_back(std::move(run));
+        }
+    }
+
+    const bool single = runs.size() == 1 && options.count("sweep") == 0;
+    for (size_t i = 0; i < runs.size(); i++) {
+        Options& values = runs[i].options;
+        if (!single) {
+            for (const char* key : {"checkpoint", "trace"}) {
+                if (!values[key].empty()) {
+                    values[key] = withRunIndex(values[key], i);
+                }
+            }
+        }
+
+        try {
+            runs[i].parameters = ATSP::parseParameters(
+                    values["method"], values["time"], values["population"], values["crossover"],
+                    values["mutation"], values["seed"], values["threads"], values["islands"],
+                    values["migration-interval"], values["migrants"], values["topology"], values["selection"],
+                    values["tournament"], values["succession"], values["replacement"], values["local-search"],
+                    values["checkpoint"], values["checkpoint-interval"], values["trace"], values["trace-interval"]);
+            if (!values["target"].empty()) {
+                runs[i].parameters.targetCost = parseLongLong(values["target"]);
+            }
+            if (!values["unique"].empty() && values["unique"] != "ON" && values["unique"] != "OFF") {
+                cerr << "ERROR: --unique must be ON or OFF, got " << values["unique"] << endl;
+                return 2;
+            }
+            runs[i].parameters.rejectDuplicates = values["unique"] == "ON";
+            if (!values["cost-cache"].empty()) {
+                runs[i].parameters.costCacheSize = max(0, parseInt(values["cost-cache"]));
+            }
+            if (!values["mutation-method"].empty()) {
+                runs[i].parameters.mutationMethod = values["mutation-method"];
+            }
+            if (!values["seeding"].empty()) {
+                runs[i].parameters.seedingMethod = values["seeding"];
+            }
+            if (!values["seeding-ratio"].empty()) {
+                runs[i].parameters.seedingRatio = parseDouble(values["seeding-ratio"]);
+            }
+            if (!values["bound"].empty()) {
+                runs[i].parameters.boundMethod = values["bound"];
+            }
+            if (!values["bound-iterations"].empty()) {
+                runs[i].parameters.boundIterations = max(1, parseInt(values["bound-iterations"]));
+            }
+            if (!values["gap"].empty()) {
+                runs[i].parameters.gapPercent = max(0.0, parseDouble(values["gap"]));
+            }
+            if (!values["stagnation"].empty()) {
+                runs[i].parameters.stagnationLimit = max(0LL, parseLongLong(values["stagnation"]));
+            }
+            if (!values["generations"].empty()) {
+                runs[i].parameters.maxGenerations = max(0LL, parseLongLong(values["generations"]));
+            }
+        } catch (const exception&) {
+            cerr << "ERROR: invalid numeric parameter value" << endl;
+            return 2;
+        }
+
+        const GAParameters& parameters = runs[i].parameters;
+        string error;
+        if (!ATSP::checkParameters(parameters, error)) {
+            cerr << "ERROR: " << error << endl;
+            return 2;
+        }
+    }
+
+    // Równoległe wykonanie przebiegów na puli z podkradaniem zadań (domyślnie tyle wątków, ile
+    // wątków sprzętowych). Przebiegi instancji od --split miast dzielone są na --split-parts części
+    int jobCount = ThreadPool::hardwareThreads();
+    int splitDimension = 0;
+    int splitParts = 0;
+    try {
+        if (options.count("jobs") != 0 && !options["jobs"].empty()) {
+            jobCount = max(1, parseInt(options["jobs"]));
+        }
+        if (options.count("split") != 0 && !options["split"].empty()) {
+            splitDimension = max(0, parseInt(options["split"]));
+        }
+        if (options.count("split-parts") != 0 && !options["split-parts"].empty()) {
+            splitParts = max(1, parseInt(options["split-parts"]));
+        }
+    } catch (const exception&) {
+        cerr << "ERROR: invalid numeric parameter value" << endl;
+        return 2;
+    }
+
+    BatchSolver batch(splitDimension > 0 ? jobCount : min(jobCount, static_cast<int>(runs.size())),
+                      distanceOptions);
+    batch.setSplitting(splitDimension, splitParts > 0 ? splitParts : jobCount);
+    for (const auto& instance : instances) {
+        batch.addInstance(instance.first, instance.second);
+    }
+    for (const Run& run : runs) {
+        batch.add(run.instance, run.parameters);
+    }
+
+    size_t finishedRuns = 0;
+    const BatchSummary summary = batch.run([&](size_t, const BatchJobResult& job) {
+        cerr << "[" << ++finishedRuns << "/" << runs.size() << "] " << job.instance << " "
+             << job.parameters.crossingMethod << " koszt: " << job.result.bestCost << endl;
+        for (const string& warning : job.result.warnings) {
+            cerr << "ERROR: " << warning << endl;
+        }
+    });
+    for (size_t i = 0; i < runs.size(); i++) {
+        const BatchJobResult& job = batch.results()[i];
+        runs[i].result = job.result;
+        runs[i].parts = job.parts;
+        runs[i].wallTime = job.wallTime();
+        runs[i].totalGenerations = job.generations;
+        runs[i].totalEvaluations = job.evaluations;
+    }
+
+    if (runs.size() > 1 || summary.steals > 0) {
+        cerr << "Partia: " << summary.jobs << " przebiegow w " << summary.wallTime << " s ("
+             << summary.jobsPerSecond() << " przebiegow/s, " << summary.evaluationsPerSecond()
+             << " obliczen kosztu/s), watki: " << summary.workers << ", wykorzystanie: "
+             << 100.0 * summary.utilization() << "%, przejete zadania: " << summary.steals << endl;
+    }
+
+    // Wyniki w formacie JSON (jeden obiekt dla pojedynczego przebiegu, tablica dla siatki)
+    ofstream outputFile;
+    if (options.count("output") != 0 && !options["output"].empty()) {
+        outputFile.open(options["output"], ios::out | ios::trunc);
+        if (!outputFile.is_open()) {
+            cerr << "ERROR while opening the output file: " << options["output"] << endl;
+            return 1;
+        }
+    }
+    ostream& output = outputFile.is_open() ? outputFile : cout;
+
+    if (single) {
+        writeRun(output, runs[0], "");
+        output << "\n";
+    } else {
+        output << "[\n";
+        for (size_t i = 0; i < runs.size(); i++) {
+            writeRun(output, runs[i], "  ");
+            output << (i + 1 < runs.size() ? ",\n" : "\n");
+        }
+        output << "]\n";
+    }
+    return 0;
+}
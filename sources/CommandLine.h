@@ -0,0 +1,39 @@
+#ifndef GENETIC_ALGORITHM_COMMANDLINE_H
+#define GENETIC_ALGORITHM_COMMANDLINE_H
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Nieinteraktywne uruchamianie algorytmu (bez menu), np. z systemu kolejkowania zadań.
+// Parametry podawane są flagami (--time 60 lub --time=60) albo w pliku konfiguracyjnym
+// (--config plik, linie "klucz = wartość", komentarze od #); flagi mają pierwszeństwo.
+// Wartości oddzielone przecinkami (np. --method OX,PMX --population 100,200) tworzą siatkę
+// parametrów, która razem z instancjami z katalogu (--sweep katalog) daje listę przebiegów
+// wykonywanych równolegle (--jobs). Wyniki wypisywane są w formacie JSON.
+class CommandLine {
+public:
+    // Zwraca kod wyjścia programu (0 - sukces)
+    static int run(int argc, char* argv[]);
+
+private:
+    using Options = map<string, string>;
+
+    static void printUsage();
+
+    static bool parseArguments(int argc, char* argv[], Options& options);
+
+    static bool parseConfigFile(const string& fileName, Options& options);
+
+    static vector<string> split(const string& value);
+
+    static vector<string> instanceFiles(const Options& options);
+
+    static vector<Options> parameterGrid(const Options& options);
+};
+
+
+#endif //GENETIC_ALGORITHM_COMMANDLINE_H
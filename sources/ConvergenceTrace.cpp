@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+
+#include "ConvergenceTrace.h"
+
+void TraceRing::allocate(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    records.assign(size, TraceRecord());
+    mask = size - 1;
+    head.store(0, memory_order_relaxed);
+    tail.store(0, memory_order_relaxed);
+}
+
+bool TraceRing::push(const TraceRecord& record) {
+    const size_t position = head.load(memory_order_relaxed);
+    if (position - tail.load(memory_order_acquire) == records.size()) {
+        return false;
+    }
+    records[position & mask] = record;
+    head.store(position + 1, memory_order_release);
+    return true;
+}
+
+bool TraceRing::pop(TraceRecord& record) {
+    const size_t position = tail.load(memory_order_relaxed);
+    if (position == head.load(memory_order_acquire)) {
+        return false;
+    }
+    record = records[position & mask];
+    tail.store(position + 1, memory_order_release);
+    return true;
+}
+
+ConvergenceTrace::~ConvergenceTrace() {
+    close();
+}
+
+bool ConvergenceTrace::open(const string& fileName, int islandCount, int dimension, size_t capacity) {
+    close();
+
+    file.open(fileName, ios::out | ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    json = fileName.size() >= 5 && fileName.compare(fileName.size() - 5, 5, ".json") == 0;
+    if (json) {
+        file << "[";
+    } else {
+        file << "time,generation,island,best,mean,diversity\n";
+    }
+
+    rings.clear();
+    successors.assign(islandCount, vector<int>(dimension, 0));
+    droppedCounts.assign(islandCount, 0);
+    for (int k = 0; k < islandCount; k++) {
+        rings.push_back(make_unique<TraceRing>());
+        rings.back()->allocate(capacity);
+    }
+    writtenCount = 0;
+
+    stopping = false;
+    writer = thread(&ConvergenceTrace::writerLoop, this);
+    return true;
+}
+
+void ConvergenceTrace::record(int islandIndex, double time, const Island& island) {
+    const PopulationArena& arena = island.arena;
+    const int populationSize = arena.populationSize();
+    const int V = arena.dimension();
+
+    // Następniki miast w najlepszej trasie bieżącego pokolenia (osobnik 0 populacji)
+    vector<int>& successor = successors[islandIndex];
+    arena.visitGenes(arena.currentSlot(0), [&](const auto* best) {
+        for (int i = 0; i < V; i++) {
+            successor[best[i]] = best[i + 1 == V ? 0 : i + 1];
+        }
+    });
+
+    // Średni koszt z całej populacji (koszty są zapamiętane w arenie)
+    long long costSum = 0;
+    for (int i = 0; i < populationSize; i++) {
+        costSum += arena.cost(arena.currentSlot(i));
+    }
+
+    // Liczba łuków nienależących do najlepszej trasy w próbce osobników (co populationSize / sample)
+    const int sample = min(populationSize, DiversitySample);
+    long long differentArcs = 0;
+    for (int s = 0; s < sample; s++) {
+        const int slot = arena.currentSlot(static_cast<int>(static_cast<long long>(s) * populationSize / sample));
+        differentArcs += arena.visitGenes(slot, [&](const auto* tour) {
+            long long count = 0;
+            for (int j = 0; j < V; j++) {
+                count += successor[tour[j]] != tour[j + 1 == V ? 0 : j + 1];
+            }
+            return count;
+        });
+    }
+
+    TraceRecord record;
+    record.time = time;
+    record.generation = island.generation;
+    record.island = islandIndex;
+    record.bestCost = island.bestIndividual.cost;
+    record.meanCost = static_cast<double>(costSum) / populationSize;
+    record.diversity = static_cast<double>(differentArcs) / (static_cast<double>(sample) * V);
+
+    if (!rings[islandIndex]->push(record)) {
+        droppedCounts[islandIndex]++;
+    }
+}
+
+void ConvergenceTrace::close() {
+    if (writer.joinable()) {
+        {
+            lock_guard<mutex> lock(writerMutex);
+            stopping = true;
+        }
+        writerCondition.notify_one();
+        writer.join();
+    }
+
+    if (file.is_open()) {
+        // Rekordy odłożone po ostatnim opróżnieniu buforów przez wątek zapisu
+        drain();
+        file << (json ? "\n]\n" : "");
+        file.close();
+    }
+}
+
+long long ConvergenceTrace::dropped() const {
+    long long total = 0;
+    for (long long count : droppedCounts) {
+        total += count;
+    }
+    return total;
+}
+
+// Wątek zapisu opróżnia bufory co 50 ms, aż do zatrzymania
+void ConvergenceTrace::writerLoop() {
+    unique_lock<mutex> lock(writerMutex);
+    while (!stopping) {
+        writerCondition.wait_for(lock, chrono::milliseconds(50));
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+void ConvergenceTrace::drain() {
+    TraceRecord record;
+    for (auto& ring : rings) {
+        while (ring->pop(record)) {
+            write(record);
+        }
+    }
+}
+
+void ConvergenceTrace::write(const TraceRecord& record) {
+    if (json) {
+        file << (writtenCount == 0 ? "\n" : ",\n")
+             << "  {\"time\": " << record.time
+             << ", \"generation\": " << record.generation
+             << ", \"island\": " << record.island
+             << ", \"best\": " << record.bestCost
+             << ", \"mean\": " << record.meanCost
+             << ", \"diversity\": " << record.diversity << "}";
+    } else {
+        file << record.time << ',' << record.generation << ',' << record.island << ','
+             << record.bestCost << ',' << record.meanCost << ',' << record.diversity << '\n';
+    }
+    writtenCount++;
+}
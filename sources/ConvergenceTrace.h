@@ -0,0 +1,108 @@
+#ifndef GENETIC_ALGORITHM_CONVERGENCETRACE_H
+#define GENETIC_ALGORITHM_CONVERGENCETRACE_H
+
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Island.h"
+
+using namespace std;
+
+// Jeden punkt przebiegu zbieżności: czas od startu, pokolenie, wyspa, najlepszy koszt (od początku
+// obliczeń), średni koszt populacji oraz różnorodność populacji (średni odsetek łuków osobników,
+// których nie ma w najlepszej trasie bieżącego pokolenia; 0 - wszystkie osobniki jednakowe).
+// Różnorodność szacowana jest na próbce DiversitySample osobników rozłożonych równomiernie w populacji.
+struct TraceRecord {
+    double time = 0.0;
+    long long generation = 0;
+    int island = 0;
+    int bestCost = 0;
+    double meanCost = 0.0;
+    double diversity = 0.0;
+};
+
+// Bufor pierścieniowy z jednym producentem (wątek wyspy) i jednym konsumentem (wątek zapisu).
+// Pojemność jest potęgą dwójki, a pamięć przydzielana jest jednorazowo. Gdy bufor jest pełny,
+// rekord jest odrzucany - producent nigdy nie czeka na zapis do pliku.
+class TraceRing {
+public:
+    void allocate(size_t capacity);
+
+    bool push(const TraceRecord& record);
+
+    bool pop(TraceRecord& record);
+
+private:
+    vector<TraceRecord> records;
+    size_t mask = 0;
+
+    // Indeksy zapisu i odczytu w osobnych liniach pamięci podręcznej
+    alignas(64) atomic<size_t> head{0};
+    alignas(64) atomic<size_t> tail{0};
+};
+
+// Zapis przebiegu zbieżności algorytmu do pliku CSV lub JSON (wybór na podstawie rozszerzenia).
+// Wątki wysp tylko odkładają rekordy do swoich buforów pierścieniowych, a plik zapisuje
+// wątek w tle, który okresowo opróżnia bufory (oraz ostatecznie przy zamknięciu).
+class ConvergenceTrace {
+public:
+    ~ConvergenceTrace();
+
+    // Otwarcie pliku i uruchomienie wątku zapisu; capacity - pojemność bufora jednej wyspy
+    bool open(const string& fileName, int islandCount, int dimension, size_t capacity = 1 << 16);
+
+    // Liczba osobników, na których szacowana jest różnorodność (koszt zapisu O(DiversitySample * V)
+    // zamiast O(populacja * V) w wątku wyspy)
+    static constexpr int DiversitySample = 16;
+
+    // Zapamiętanie stanu wyspy (wywoływane przez wątek wyspy, bez alokacji pamięci)
+    void record(int islandIndex, double time, const Island& island);
+
+    // Zatrzymanie wątku zapisu, zapis pozostałych rekordów i zamknięcie pliku
+    void close();
+
+    bool isOpen() const {
+        return file.is_open();
+    }
+
+    long long written() const {
+        return writtenCount;
+    }
+
+    long long dropped() const;
+
+private:
+    ofstream file;
+    bool json = false;
+
+    vector<unique_ptr<TraceRing>> rings;
+
+    // Bufory do wyznaczania różnorodności (następnik każdego miasta w najlepszej trasie)
+    vector<vector<int>> successors;
+
+    // Liczniki odrzuconych rekordów (po jednym na wyspę - zapisywane tylko przez jej wątek)
+    vector<long long> droppedCounts;
+
+    long long writtenCount = 0;
+
+    thread writer;
+    mutex writerMutex;
+    condition_variable writerCondition;
+    bool stopping = false;
+
+    void writerLoop();
+
+    void drain();
+
+    void write(const TraceRecord& record);
+};
+
+
+#endif //GENETIC_ALGORITHM_CONVERGENCETRACE_H
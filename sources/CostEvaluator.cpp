@@ -0,0 +1,209 @@
+#include "CostEvaluator.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define GA_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(GA_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GA_TARGET(name) __attribute__((target(name)))
+#else
+#define GA_TARGET(name)
+#endif
+
+namespace {
+
+// Jądro skalarne - wersja awaryjna dostępna na każdym procesorze
+template<typename Gene, typename Distance>
+int scalarCost(const Distance* matrix, int V, const Gene* tour) {
+    int cost = 0;
+
+    for (int i = 0; i < V - 1; ++i) {
+        cost += matrix[static_cast<size_t>(tour[i]) * V + tour[i + 1]];
+    }
+
+    // Dodanie kosztu powrotu do pierwszego miasta (cyklu)
+    cost += matrix[static_cast<size_t>(tour[V - 1]) * V + tour[0]];
+
+    return cost;
+}
+
+#ifdef GA_X86
+
+// Wczytanie 8 kolejnych genów jako liczb 32-bitowych
+template<typename Gene>
+GA_TARGET("avx2")
+inline __m256i loadGenes8(const Gene* genes) {
+    if constexpr (sizeof(Gene) == sizeof(uint16_t)) {
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(genes)));
+    } else {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(genes));
+    }
+}
+
+// Zebranie 8 odległości o podanych indeksach. Elementy 16-bitowe pobierane są jako słowa
+// 32-bitowe spod adresu elementu i rozszerzane ze znakiem - odczyt 2 bajtów za elementem
+// mieści się w macierzy, bo ostatni jej element (i, i) nie jest łukiem trasy
+template<typename Distance>
+GA_TARGET("avx2")
+inline __m256i gatherDistances8(const Distance* matrix, __m256i index) {
+    if constexpr (sizeof(Distance) == sizeof(int16_t)) {
+        const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(matrix), index, 2);
+        return _mm256_srai_epi32(_mm256_slli_epi32(words, 16), 16);
+    } else {
+        return _mm256_i32gather_epi32(reinterpret_cast<const int*>(matrix), index, 4);
+    }
+}
+
+// Jądro AVX2 - 8 łuków trasy naraz (indeksy from * V + to i zbieranie odległości instrukcją gather)
+template<typename Gene, typename Distance>
+GA_TARGET("avx2")
+int avx2Cost(const Distance* matrix, int V, const Gene* tour) {
+    const __m256i dimension = _mm256_set1_epi32(V);
+    __m256i sum = _mm256_setzero_si256();
+
+    int i = 0;
+    for (; i + 8 < V; i += 8) {
+        __m256i from = loadGenes8(tour + i);
+        __m256i to = loadGenes8(tour + i + 1);
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(from, dimension), to);
+        sum = _mm256_add_epi32(sum, gatherDistances8(matrix, index));
+    }
+
+    // Redukcja sumy częściowej z 8 pasów
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    int cost = _mm_cvtsi128_si32(half);
+
+    // Pozostałe łuki oraz powrót do pierwszego miasta
+    for (; i < V - 1; ++i) {
+        cost += matrix[static_cast<size_t>(tour[i]) * V + tour[i + 1]];
+    }
+    cost += matrix[static_cast<size_t>(tour[V - 1]) * V + tour[0]];
+
+    return cost;
+}
+
+template<typename Gene>
+GA_TARGET("avx512f")
+inline __m512i loadGenes16(const Gene* genes) {
+    if constexpr (sizeof(Gene) == sizeof(uint16_t)) {
+        return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(genes)));
+    } else {
+        return _mm512_loadu_si512(genes);
+    }
+}
+
+template<typename Distance>
+GA_TARGET("avx512f")
+inline __m512i gatherDistances16(const Distance* matrix, __m512i index) {
+    if constexpr (sizeof(Distance) == sizeof(int16_t)) {
+        const __m512i words = _mm512_i32gather_epi32(index, matrix, 2);
+        return _mm512_srai_epi32(_mm512_slli_epi32(words, 16), 16);
+    } else {
+        return _mm512_i32gather_epi32(index, matrix, 4);
+    }
+}
+
+// Jądro AVX-512 - 16 łuków trasy naraz
+template<typename Gene, typename Distance>
+GA_TARGET("avx512f")
+int avx512Cost(const Distance* matrix, int V, const Gene* tour) {
+    const __m512i dimension = _mm512_set1_epi32(V);
+    __m512i sum = _mm512_setzero_si512();
+
+    int i = 0;
+    for (; i + 16 < V; i += 16) {
+        __m512i from = loadGenes16(tour + i);
+        __m512i to = loadGenes16(tour + i + 1);
+        __m512i index = _mm512_add_epi32(_mm512_mullo_epi32(from, dimension), to);
+        sum = _mm512_add_epi32(sum, gatherDistances16(matrix, index));
+    }
+
+    int cost = _mm512_reduce_add_epi32(sum);
+
+    for (; i < V - 1; ++i) {
+        cost += matrix[static_cast<size_t>(tour[i]) * V + tour[i + 1]];
+    }
+    cost += matrix[static_cast<size_t>(tour[V - 1]) * V + tour[0]];
+
+    return cost;
+}
+
+#endif
+
+}
+
+CostEvaluator::CostEvaluator() : CostEvaluator(detectKernel()) {}
+
+CostEvaluator::CostEvaluator(Kernel forcedKernel) : selectedKernel(forcedKernel) {
+    // Na procesorach innych niż x86 zawsze używane jest jądro skalarne
+    if (functionFor<int, int32_t>(forcedKernel) == scalarCost<int, int32_t>) {
+        selectedKernel = Kernel::Scalar;
+    }
+}
+
+const char* CostEvaluator::kernelName() const {
+    switch (selectedKernel) {
+        case Kernel::AVX512:
+            return "AVX-512";
+        case Kernel::AVX2:
+            return "AVX2";
+        default:
+            return "Scalar";
+    }
+}
+
+// Wykrycie najszerszego zestawu instrukcji obsługiwanego przez procesor (i system)
+CostEvaluator::Kernel CostEvaluator::detectKernel() {
+#if defined(GA_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return Kernel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return Kernel::AVX2;
+    }
+#elif defined(GA_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    __cpuidex(info, 7, 0);
+    if ((xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16))) {
+        return Kernel::AVX512;
+    }
+    if ((xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5))) {
+        return Kernel::AVX2;
+    }
+#endif
+    return Kernel::Scalar;
+}
+
+template<typename Gene, typename Distance>
+CostEvaluator::KernelFunction<Gene, Distance> CostEvaluator::functionFor(Kernel kernel) {
+#ifdef GA_X86
+    switch (kernel) {
+        case Kernel::AVX512:
+            return avx512Cost<Gene, Distance>;
+        case Kernel::AVX2:
+            return avx2Cost<Gene, Distance>;
+        default:
+            break;
+    }
+#endif
+    return scalarCost<Gene, Distance>;
+}
+
+// Konkretyzacje dla genów uint16_t i int oraz odległości 16- i 32-bitowych
+template CostEvaluator::KernelFunction<uint16_t, int16_t> CostEvaluator::functionFor(Kernel kernel);
+
+template CostEvaluator::KernelFunction<uint16_t, int32_t> CostEvaluator::functionFor(Kernel kernel);
+
+template CostEvaluator::KernelFunction<int, int16_t> CostEvaluator::functionFor(Kernel kernel);
+
+template CostEvaluator::KernelFunction<int, int32_t> CostEvaluator::functionFor(Kernel kernel);
@@ -0,0 +1,110 @@
+#ifndef GENETIC_ALGORITHM_COSTEVALUATOR_H
+#define GENETIC_ALGORITHM_COSTEVALUATOR_H
+
+
+#include <vector>
+
+#include "DistanceProvider.h"
+#include "PopulationArena.h"
+
+using namespace std;
+
+// Wsadowe obliczanie kosztu tras. Wersja jądra (skalarna, AVX2 lub AVX-512)
+// wybierana jest raz, w czasie działania programu, na podstawie możliwości procesora.
+// Jądra są szablonami typu genu (uint16_t, int) i typu odległości (int16_t, int32_t);
+// węższe elementy są rozszerzane do 32 bitów przed sumowaniem, więc suma kosztu nie
+// przepełnia się, o ile koszt trasy mieści się w typie int (sprawdzane przy wczytywaniu).
+// Dla odległości bez ciągłej macierzy (współrzędne, łuki rzadkie) używana jest pętla skalarna.
+class CostEvaluator {
+public:
+    enum class Kernel {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    template<typename Gene, typename Distance>
+    using KernelFunction = int (*)(const Distance* matrix, int V, const Gene* tour);
+
+    CostEvaluator();
+
+    explicit CostEvaluator(Kernel forcedKernel);
+
+    // Koszt pojedynczej trasy (cyklu) o długości równej rozmiarowi macierzy
+    template<typename Gene, typename Distance>
+    int cost(const DistanceView<Distance>& matrix, const Gene* tour) const {
+        return kernelFunction<Gene, Distance>(matrix.dimension())(matrix.data(), matrix.dimension(), tour);
+    }
+
+    // Koszt trasy dla dowolnego widoku odległości (współrzędne, łuki rzadkie)
+    template<typename Gene, typename Distances>
+    int cost(const Distances& distances, const Gene* tour) const {
+        const int V = distances.dimension();
+        int cost = 0;
+        for (int i = 0; i < V - 1; ++i) {
+            cost += distances(tour[i], tour[i + 1]);
+        }
+        return cost + distances(tour[V - 1], tour[0]);
+    }
+
+    // Obliczenie kosztów wszystkich zmienionych (dirty) osobników ze wskazanych slotów areny,
+    // zwracana jest liczba faktycznie obliczonych kosztów
+    template<typename Gene, typename Distance>
+    int evaluateBatch(const DistanceView<Distance>& matrix, PopulationArena& arena, const int* slots,
+                      int count) const {
+        const KernelFunction<Gene, Distance> function = kernelFunction<Gene, Distance>(matrix.dimension());
+        int evaluated = 0;
+
+        for (int i = 0; i < count; i++) {
+            const int slot = slots[i];
+            if (arena.isDirty(slot)) {
+                arena.cost(slot) = function(matrix.data(), matrix.dimension(), arena.genes<Gene>(slot));
+                arena.setDirty(slot, false);
+                evaluated++;
+            }
+        }
+        return evaluated;
+    }
+
+    template<typename Gene, typename Distances>
+    int evaluateBatch(const Distances& distances, PopulationArena& arena, const int* slots, int count) const {
+        int evaluated = 0;
+
+        for (int i = 0; i < count; i++) {
+            const int slot = slots[i];
+            if (arena.isDirty(slot)) {
+                arena.cost(slot) = cost(distances, arena.genes<Gene>(slot));
+                arena.setDirty(slot, false);
+                evaluated++;
+            }
+        }
+        return evaluated;
+    }
+
+    Kernel kernel() const {
+        return selectedKernel;
+    }
+
+    const char* kernelName() const;
+
+    static Kernel detectKernel();
+
+    // Jądro dla wybranej wersji i typów elementów (konkretyzacje w CostEvaluator.cpp)
+    template<typename Gene, typename Distance>
+    static KernelFunction<Gene, Distance> functionFor(Kernel kernel);
+
+private:
+    Kernel selectedKernel;
+
+    // Jądra wektorowe liczą indeksy elementów macierzy na 32 bitach - dla większych
+    // instancji używane jest jądro skalarne
+    static constexpr int MaxVectorDimension = 46340;
+
+    template<typename Gene, typename Distance>
+    KernelFunction<Gene, Distance> kernelFunction(int V) const {
+        return functionFor<Gene, Distance>(V <= MaxVectorDimension ? selectedKernel : Kernel::Scalar);
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_COSTEVALUATOR_H
@@ -0,0 +1,39 @@
+#ifndef GENETIC_ALGORITHM_CROSSOVERSCRATCH_H
+#define GENETIC_ALGORITHM_CROSSOVERSCRATCH_H
+
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Bufory pomocnicze operatorów krzyżowania, alokowane raz dla każdego wątku roboczego.
+// present - mapa bitowa obecności genów w potomku (OX),
+// position1/position2 - pozycje genów w potomkach (PMX).
+struct CrossoverScratch {
+    vector<uint64_t> present;
+    vector<int> position1;
+    vector<int> position2;
+
+    void resize(int V) {
+        present.assign((V + 63) / 64, 0);
+        position1.assign(V, 0);
+        position2.assign(V, 0);
+    }
+
+    bool isPresent(int gene) const {
+        return (present[gene >> 6] >> (gene & 63)) & 1;
+    }
+
+    void markPresent(int gene) {
+        present[gene >> 6] |= uint64_t(1) << (gene & 63);
+    }
+
+    void clearPresent() {
+        fill(present.begin(), present.end(), 0);
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_CROSSOVERSCRATCH_H
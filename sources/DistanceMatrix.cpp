@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "DistanceMatrix.h"
+
+DistanceMatrix::DistanceMatrix(const DistanceMatrix& other)
+        : V(other.V), width(other.width), values(other.values), mapping(other.mapping),
+          mappingOffset(other.mappingOffset) {
+    rebind();
+}
+
+DistanceMatrix& DistanceMatrix::operator=(const DistanceMatrix& other) {
+    if (this != &other) {
+        V = other.V;
+        width = other.width;
+        values = other.values;
+        mapping = other.mapping;
+        mappingOffset = other.mappingOffset;
+        rebind();
+    }
+    return *this;
+}
+
+DistanceMatrix::DistanceMatrix(DistanceMatrix&& other) noexcept
+        : V(other.V), width(other.width), values(std::move(other.values)), mapping(std::move(other.mapping)),
+          mappingOffset(other.mappingOffset) {
+    rebind();
+    other.V = 0;
+    other.cells = nullptr;
+}
+
+DistanceMatrix& DistanceMatrix::operator=(DistanceMatrix&& other) noexcept {
+    if (this != &other) {
+        V = other.V;
+        width = other.width;
+        values = std::move(other.values);
+        mapping = std::move(other.mapping);
+        mappingOffset = other.mappingOffset;
+        rebind();
+        other.V = 0;
+        other.cells = nullptr;
+    }
+    return *this;
+}
+
+// Metoda zmieniająca rozmiar macierzy (zawartość jest zerowana)
+void DistanceMatrix::resize(int newDimension) {
+    V = newDimension;
+    width = sizeof(int32_t);
+    mapping.reset();
+    values = make_shared<Buffer>(byteSize(), 0);
+    rebind();
+}
+
+// Metoda zwalniająca pamięć macierzy
+void DistanceMatrix::clear() {
+    V = 0;
+    width = sizeof(int32_t);
+    mapping.reset();
+    values.reset();
+    rebind();
+}
+
+// Metoda przełączająca macierz na odległości zapisane w odwzorowanym pliku (bez kopiowania)
+void DistanceMatrix::attach(shared_ptr<MappedFile> file, size_t offset, int newDimension, int newElementWidth) {
+    values.reset();
+    V = newDimension;
+    width = newElementWidth;
+    mapping = std::move(file);
+    mappingOffset = offset;
+    rebind();
+}
+
+// Metoda zawężająca elementy macierzy do 16 bitów (jeśli wszystkie odległości się mieszczą)
+bool DistanceMatrix::narrow() {
+    if (width == sizeof(int16_t) || V == 0) {
+        return width == sizeof(int16_t);
+    }
+
+    const size_t count = static_cast<size_t>(V) * V;
+    const int32_t* source = reinterpret_cast<const int32_t*>(cells);
+    const bool fits = all_of(source, source + count, [](int32_t value) {
+        return value >= numeric_limits<int16_t>::min() && value <= numeric_limits<int16_t>::max();
+    });
+    if (!fits) {
+        return false;
+    }
+
+    auto narrowed = make_shared<Buffer>(count * sizeof(int16_t));
+    int16_t* destination = reinterpret_cast<int16_t*>(narrowed->data());
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = static_cast<int16_t>(source[i]);
+    }
+
+    values = std::move(narrowed);
+    width = sizeof(int16_t);
+    mapping.reset();
+    rebind();
+    return true;
+}
+
+long long DistanceMatrix::tourCostBound() const {
+    long long bound = 0;
+    for (int from = 0; from < V; from++) {
+        long long rowMaximum = 0;
+        for (int to = 0; to < V; to++) {
+            if (to != from) {
+                rowMaximum = max(rowMaximum, static_cast<long long>(llabs((*this)(from, to))));
+            }
+        }
+        bound += rowMaximum;
+    }
+    return bound;
+}
+
+// Ustawienie wskaźnika na początek właściwego bufora (po zmianie rozmiaru, kopiowaniu lub przeniesieniu)
+void DistanceMatrix::rebind() {
+    if (mapping != nullptr) {
+        cells = reinterpret_cast<unsigned char*>(mapping->mutableData()) + mappingOffset;
+    } else {
+        cells = values != nullptr ? values->data() : nullptr;
+    }
+}
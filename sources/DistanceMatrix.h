@@ -0,0 +1,170 @@
+#ifndef GENETIC_ALGORITHM_DISTANCEMATRIX_H
+#define GENETIC_ALGORITHM_DISTANCEMATRIX_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+// Alokator przydzielający pamięć wyrównaną do zadanej granicy (domyślnie linii pamięci podręcznej)
+template<typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), align_val_t(Alignment)));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+        ::operator delete(pointer, align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+// Widok macierzy odległości o elementach typu Distance (int16_t albo int32_t) używany przez
+// szablony pętli algorytmu - odczyt elementu nie wymaga sprawdzania szerokości elementów
+template<typename Distance>
+struct DistanceView {
+    using Element = Distance;
+
+    const Distance* cells = nullptr;
+    int V = 0;
+
+    int dimension() const {
+        return V;
+    }
+
+    int operator()(int from, int to) const {
+        return cells[static_cast<size_t>(from) * V + to];
+    }
+
+    const Distance* data() const {
+        return cells;
+    }
+};
+
+// Macierz odległości przechowywana w jednym, ciągłym buforze (wierszami),
+// wyrównanym do linii pamięci podręcznej. Element (i, j) znajduje się pod indeksem i * V + j.
+// Elementy mają szerokość 4 bajtów (int32_t) albo, jeśli wszystkie odległości się mieszczą,
+// 2 bajtów (int16_t) - węższe elementy to dwa razy mniej danych odczytywanych przy obliczaniu kosztu.
+// Bufor może należeć do macierzy albo być fragmentem pliku odwzorowanego w pamięci
+// (binarna kopia instancji wczytywana bez kopiowania danych). Kopie macierzy współdzielą bufor
+// (np. zadania wsadowe rozwiązujące tę samą instancję), więc po wczytaniu macierz jest niezmienna.
+class DistanceMatrix {
+public:
+    // Rozmiar linii pamięci podręcznej, do której wyrównany jest bufor
+    static constexpr size_t CacheLineSize = 64;
+
+    DistanceMatrix() = default;
+
+    DistanceMatrix(const DistanceMatrix& other);
+
+    DistanceMatrix& operator=(const DistanceMatrix& other);
+
+    DistanceMatrix(DistanceMatrix&& other) noexcept;
+
+    DistanceMatrix& operator=(DistanceMatrix&& other) noexcept;
+
+    // Zmiana rozmiaru macierzy - elementy 32-bitowe, zawartość jest zerowana
+    void resize(int newDimension);
+
+    void clear();
+
+    // Użycie odległości zapisanych w pliku odwzorowanym w pamięci (od przesunięcia offset,
+    // wyrównanego do linii pamięci podręcznej); odwzorowanie musi być typu copy-on-write
+    void attach(shared_ptr<MappedFile> file, size_t offset, int newDimension, int newElementWidth);
+
+    // Zamiana elementów na 16-bitowe, jeśli mieszczą się w nich wszystkie odległości
+    bool narrow();
+
+    // Górne ograniczenie wartości bezwzględnej kosztu dowolnej trasy (suma największych
+    // odległości wychodzących z miast) - pozwala sprawdzić, czy koszt mieści się w typie int
+    long long tourCostBound() const;
+
+    bool isMapped() const {
+        return mapping != nullptr;
+    }
+
+    int dimension() const {
+        return V;
+    }
+
+    bool empty() const {
+        return V == 0;
+    }
+
+    int elementWidth() const {
+        return width;
+    }
+
+    // Element do zapisu - tylko dla macierzy o elementach 32-bitowych (przed zawężeniem),
+    // wypełnianej zaraz po resize, zanim powstaną jej kopie
+    int& cell(int from, int to) {
+        return reinterpret_cast<int32_t*>(cells)[static_cast<size_t>(from) * V + to];
+    }
+
+    int operator()(int from, int to) const {
+        const size_t index = static_cast<size_t>(from) * V + to;
+        return width == sizeof(int16_t) ? reinterpret_cast<const int16_t*>(cells)[index]
+                                        : reinterpret_cast<const int32_t*>(cells)[index];
+    }
+
+    // Widok macierzy dla typu elementów zgodnego z elementWidth()
+    template<typename Distance>
+    DistanceView<Distance> view() const {
+        return DistanceView<Distance>{reinterpret_cast<const Distance*>(cells), V};
+    }
+
+    // Surowy bufor macierzy (V * V * elementWidth() bajtów)
+    const unsigned char* bytes() const {
+        return cells;
+    }
+
+    size_t byteSize() const {
+        return static_cast<size_t>(V) * V * width;
+    }
+
+private:
+    // Liczba miast
+    int V = 0;
+
+    // Szerokość elementu w bajtach (sizeof(int16_t) albo sizeof(int32_t))
+    int width = sizeof(int32_t);
+
+    // Początek aktualnie używanego bufora (values albo fragment odwzorowanego pliku)
+    unsigned char* cells = nullptr;
+
+    // Bufor odległości (V * V elementów), współdzielony przez kopie macierzy
+    using Buffer = vector<unsigned char, AlignedAllocator<unsigned char, CacheLineSize>>;
+    shared_ptr<Buffer> values;
+
+    // Plik odwzorowany w pamięci, współdzielony przez kopie macierzy
+    shared_ptr<MappedFile> mapping;
+    size_t mappingOffset = 0;
+
+    void rebind();
+};
+
+
+#endif //GENETIC_ALGORITHM_DISTANCEMATRIX_H
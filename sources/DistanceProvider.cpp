@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+#include "DistanceProvider.h"
+
+namespace {
+
+    int nint(double value) {
+        return static_cast<int>(value + 0.5);
+    }
+
+    // Promień Ziemi w kilometrach dla typu GEO (specyfikacja TSPLIB)
+    const double RRR = 6378.388;
+}
+
+int CoordinateDistances::planar(CoordinateMetric metric, double dx, double dy) {
+    switch (metric) {
+        case CoordinateMetric::Ceiling:
+            return static_cast<int>(ceil(sqrt(dx * dx + dy * dy)));
+        case CoordinateMetric::Manhattan:
+            return nint(fabs(dx) + fabs(dy));
+        case CoordinateMetric::Maximum:
+            return max(nint(fabs(dx)), nint(fabs(dy)));
+        case CoordinateMetric::Att: {
+            // Pseudo-euklidesowa odległość z instancji att48/att532
+            double r = sqrt((dx * dx + dy * dy) / 10.0);
+            int t = nint(r);
+            return t < r ? t + 1 : t;
+        }
+        default:
+            return nint(sqrt(dx * dx + dy * dy));
+    }
+}
+
+int CoordinateDistances::geographic(int from, int to) const {
+    double q1 = cos(y[from] - y[to]);
+    double q2 = cos(x[from] - x[to]);
+    double q3 = cos(x[from] + x[to]);
+    return static_cast<int>(RRR * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+}
+
+int CoordinateDistances::maximumDistance() const {
+    if (V < 2) {
+        return 0;
+    }
+    if (metric == CoordinateMetric::Geographic) {
+        // Połowa obwodu Ziemi
+        return static_cast<int>(RRR * 3.141593 + 1.0) + 1;
+    }
+    const auto [minX, maxX] = minmax_element(x, x + V);
+    const auto [minY, maxY] = minmax_element(y, y + V);
+    return planar(metric, *maxX - *minX, *maxY - *minY);
+}
+
+long long CoordinateDistances::tourCostBound() const {
+    if (V < 2) {
+        return 0;
+    }
+    if (metric == CoordinateMetric::Geographic) {
+        return static_cast<long long>(V) * maximumDistance();
+    }
+    const auto [minX, maxX] = minmax_element(x, x + V);
+    const auto [minY, maxY] = minmax_element(y, y + V);
+    long long bound = 0;
+    for (int city = 0; city < V; city++) {
+        bound += planar(metric, max(x[city] - *minX, *maxX - x[city]), max(y[city] - *minY, *maxY - y[city]));
+    }
+    return bound;
+}
+
+void CoordinateDistances::nearestNeighbours(int k, vector<int>& neighbours) const {
+    k = max(0, min(k, V - 1));
+    neighbours.assign(static_cast<size_t>(V) * k, 0);
+    if (k == 0) {
+        return;
+    }
+
+    // Kopiec k najlepszych kandydatów (odległość, miasto) - na szczycie najgorszy z nich
+    vector<pair<int, int>> best;
+    best.reserve(k + 1);
+    auto offer = [&](int city, int other) {
+        const pair<int, int> candidate((*this)(city, other), other);
+        if (static_cast<int>(best.size()) < k) {
+            best.push_back(candidate);
+            push_heap(best.begin(), best.end());
+        } else if (candidate < best.front()) {
+            pop_heap(best.begin(), best.end());
+            best.back() = candidate;
+            push_heap(best.begin(), best.end());
+        }
+    };
+    auto store = [&](int city) {
+        sort_heap(best.begin(), best.end());
+        for (int i = 0; i < k; i++) {
+            neighbours[static_cast<size_t>(city) * k + i] = best[i].second;
+        }
+        best.clear();
+    };
+
+    // Odległość GEO nie rośnie razem z różnicą współrzędnych - przegląd wszystkich par
+    if (metric == CoordinateMetric::Geographic) {
+        for (int city = 0; city < V; city++) {
+            for (int other = 0; other < V; other++) {
+                if (other != city) {
+                    offer(city, other);
+                }
+            }
+            store(city);
+        }
+        return;
+    }
+
+    // Siatka kwadratowych kubełków, średnio dwa miasta na kubełek
+    const auto [minX, maxX] = minmax_element(x, x + V);
+    const auto [minY, maxY] = minmax_element(y, y + V);
+    const double width = *maxX - *minX;
+    const double height = *maxY - *minY;
+    const double targetCells = max(1.0, V / 2.0);
+    double cellSize = sqrt(width * height / targetCells);
+    if (!(cellSize > 0.0)) {
+        cellSize = max(width, height) / targetCells;
+    }
+    if (!(cellSize > 0.0)) {
+        cellSize = 1.0;
+    }
+    const int columns = static_cast<int>(width / cellSize) + 1;
+    const int rows = static_cast<int>(height / cellSize) + 1;
+
+    auto column = [&](int city) {
+        return min(columns - 1, static_cast<int>((x[city] - *minX) / cellSize));
+    };
+    auto row = [&](int city) {
+        return min(rows - 1, static_cast<int>((y[city] - *minY) / cellSize));
+    };
+
+    // Miasta kubełków w jednej tablicy (sortowanie przez zliczanie)
+    vector<int> cellStart(static_cast<size_t>(columns) * rows + 1, 0);
+    for (int city = 0; city < V; city++) {
+        cellStart[static_cast<size_t>(row(city)) * columns + column(city) + 1]++;
+    }
+    for (size_t cell = 1; cell < cellStart.size(); cell++) {
+        cellStart[cell] += cellStart[cell - 1];
+    }
+    vector<int> cellCities(V);
+    vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int city = 0; city < V; city++) {
+        cellCities[fill[static_cast<size_t>(row(city)) * columns + column(city)]++] = city;
+    }
+
+    auto scanCell = [&](int city, int cellColumn, int cellRow) {
+        if (cellColumn < 0 || cellColumn >= columns || cellRow < 0 || cellRow >= rows) {
+            return;
+        }
+        const size_t cell = static_cast<size_t>(cellRow) * columns + cellColumn;
+        for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+            if (cellCities[i] != city) {
+                offer(city, cellCities[i]);
+            }
+        }
+    };
+
+    // Przeglądanie kolejnych pierścieni kubełków wokół miasta. Miasta z pierścienia r + 1 różnią się
+    // co najmniej o r * cellSize w jednej ze współrzędnych, więc przegląd kończy się, gdy k-ty
+    // kandydat jest bliżej niż ta granica
+    const int maxRing = max(columns, rows);
+    for (int city = 0; city < V; city++) {
+        const int cityColumn = column(city);
+        const int cityRow = row(city);
+
+        for (int ring = 0; ring <= maxRing; ring++) {
+            for (int dy = -ring; dy <= ring; dy++) {
+                if (dy == -ring || dy == ring) {
+                    for (int dx = -ring; dx <= ring; dx++) {
+                        scanCell(city, cityColumn + dx, cityRow + dy);
+                    }
+                } else {
+                    scanCell(city, cityColumn - ring, cityRow + dy);
+                    scanCell(city, cityColumn + ring, cityRow + dy);
+                }
+            }
+            if (static_cast<int>(best.size()) == k && best.front().first < planar(metric, ring * cellSize, 0.0)) {
+                break;
+            }
+        }
+        store(city);
+    }
+}
+
+DistanceProvider::Storage DistanceProvider::storageFromName(const string& name) {
+    if (name == "DENSE") {
+        return Storage::Dense;
+    }
+    if (name == "COORDINATES") {
+        return Storage::Coordinates;
+    }
+    if (name == "SPARSE") {
+        return Storage::Sparse;
+    }
+    return Storage::Auto;
+}
+
+const char* DistanceProvider::storageName(Storage storage) {
+    switch (storage) {
+        case Storage::Dense:
+            return "DENSE";
+        case Storage::Coordinates:
+            return "COORDINATES";
+        case Storage::Sparse:
+            return "SPARSE";
+        default:
+            return "AUTO";
+    }
+}
+
+DistanceMatrix& DistanceProvider::useMatrix() {
+    kind = Storage::Dense;
+    V = 0;
+    coordinateData.reset();
+    sparseData.reset();
+    return denseMatrix;
+}
+
+void DistanceProvider::useCoordinates(int newDimension, vector<double> x, vector<double> y,
+                                      CoordinateMetric metric) {
+    clear();
+    kind = Storage::Coordinates;
+    V = newDimension;
+    coordinateData = make_shared<const CoordinateData>(CoordinateData{std::move(x), std::move(y), metric});
+}
+
+void DistanceProvider::useSparse(int newDimension, vector<int> offsets, vector<int> targets, vector<int> weights,
+                                 int penalty) {
+    clear();
+    kind = Storage::Sparse;
+    V = newDimension;
+    sparseData = make_shared<const SparseData>(
+            SparseData{std::move(offsets), std::move(targets), std::move(weights), penalty});
+}
+
+void DistanceProvider::clear() {
+    kind = Storage::Dense;
+    V = 0;
+    denseMatrix.clear();
+    coordinateData.reset();
+    sparseData.reset();
+}
+
+CoordinateDistances DistanceProvider::coordinates() const {
+    if (coordinateData == nullptr) {
+        return CoordinateDistances();
+    }
+    return CoordinateDistances{coordinateData->x.data(), coordinateData->y.data(), V, coordinateData->metric};
+}
+
+SparseDistances DistanceProvider::sparse() const {
+    if (sparseData == nullptr) {
+        return SparseDistances();
+    }
+    return SparseDistances{sparseData->offsets.data(), sparseData->targets.data(), sparseData->weights.data(), V,
+                           sparseData->penalty};
+}
+
+int DistanceProvider::operator()(int from, int to) const {
+    return visit([&](const auto& distances) {
+        return distances(from, to);
+    });
+}
+
+long long DistanceProvider::tourCostBound() const {
+    switch (kind) {
+        case Storage::Coordinates:
+            return coordinates().tourCostBound();
+        case Storage::Sparse: {
+            // Największy łuk wychodzący z miasta - zapamiętany albo łuk o koszcie kary
+            const SparseData& data = *sparseData;
+            long long bound = 0;
+            for (int from = 0; from < V; from++) {
+                long long rowMaximum = llabs(data.penalty);
+                for (int i = data.offsets[from]; i < data.offsets[from + 1]; i++) {
+                    rowMaximum = max(rowMaximum, llabs(data.weights[i]));
+                }
+                bound += rowMaximum;
+            }
+            return bound;
+        }
+        default:
+            return denseMatrix.tourCostBound();
+    }
+}
+
+int DistanceProvider::distanceBits() const {
+    return kind == Storage::Dense ? 8 * denseMatrix.elementWidth() : 8 * static_cast<int>(sizeof(int32_t));
+}
+
+size_t DistanceProvider::byteSize() const {
+    switch (kind) {
+        case Storage::Coordinates:
+            return 2 * static_cast<size_t>(V) * sizeof(double);
+        case Storage::Sparse:
+            return (sparseData->offsets.size() + sparseData->targets.size() + sparseData->weights.size()) *
+                   sizeof(int);
+        default:
+            return denseMatrix.byteSize();
+    }
+}
@@ -0,0 +1,229 @@
+#ifndef GENETIC_ALGORITHM_DISTANCEPROVIDER_H
+#define GENETIC_ALGORITHM_DISTANCEPROVIDER_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "DistanceMatrix.h"
+
+using namespace std;
+
+// Źródła odległości między miastami. Wszystkie udostępniają ten sam interfejs widoku
+// (dimension() i operator()(from, to), -1 na głównej przekątnej), więc operatory genetyczne,
+// ruchy, przeszukiwanie lokalne i obliczanie kosztu są szablonami działającymi z każdym z nich:
+// - DistanceView<int16_t> / DistanceView<int32_t> - pełna macierz (V * V elementów),
+// - CoordinateDistances - odległości liczone na bieżąco ze współrzędnych (16 bajtów na miasto),
+// - SparseDistances - k najbliższych następników każdego miasta, pozostałe łuki mają koszt kary.
+
+// Wzory odległości dla współrzędnych (EDGE_WEIGHT_TYPE z biblioteki TSPLIB)
+enum class CoordinateMetric {
+    Euclidean,
+    Ceiling,
+    Manhattan,
+    Maximum,
+    Att,
+    Geographic
+};
+
+// Widok odległości liczonych ze współrzędnych. Dla typu GEO współrzędne są szerokością
+// i długością geograficzną w radianach (przeliczone przy wczytywaniu).
+struct CoordinateDistances {
+    const double* x = nullptr;
+    const double* y = nullptr;
+    int V = 0;
+    CoordinateMetric metric = CoordinateMetric::Euclidean;
+
+    int dimension() const {
+        return V;
+    }
+
+    int operator()(int from, int to) const {
+        if (from == to) {
+            return -1;
+        }
+        if (metric == CoordinateMetric::Geographic) {
+            return geographic(from, to);
+        }
+        return planar(metric, x[from] - x[to], y[from] - y[to]);
+    }
+
+    // Odległość dla różnicy współrzędnych (dx, dy) według wzorów specyfikacji TSPLIB
+    static int planar(CoordinateMetric metric, double dx, double dy);
+
+    // Największa odległość między dwoma miastami (z prostokąta ograniczającego współrzędne)
+    int maximumDistance() const;
+
+    // Górne ograniczenie kosztu trasy - suma odległości miast od najdalszego rogu prostokąta
+    // ograniczającego współrzędne
+    long long tourCostBound() const;
+
+    // Lista k najbliższych sąsiadów każdego miasta (V * k elementów, od najbliższego).
+    // Dla wzorów płaskich sąsiedzi wyszukiwani są w siatce kubełków, dla GEO - przeglądem wszystkich miast
+    void nearestNeighbours(int k, vector<int>& neighbours) const;
+
+private:
+    int geographic(int from, int to) const;
+};
+
+// Widok rzadkiego zbioru łuków: dla miasta from łuki targets/weights[offsets[from] .. offsets[from + 1])
+// uporządkowane od najtańszego. Łuk spoza zbioru ma koszt penalty (domyślnie największa odległość
+// w instancji), więc algorytm unika tras przez łuki, których koszt nie jest znany.
+struct SparseDistances {
+    const int* offsets = nullptr;
+    const int* targets = nullptr;
+    const int* weights = nullptr;
+    int V = 0;
+    int penalty = 0;
+
+    int dimension() const {
+        return V;
+    }
+
+    int operator()(int from, int to) const {
+        if (from == to) {
+            return -1;
+        }
+        for (int i = offsets[from]; i < offsets[from + 1]; i++) {
+            if (targets[i] == to) {
+                return weights[i];
+            }
+        }
+        return penalty;
+    }
+};
+
+// Właściciel danych wczytanej instancji w jednej z trzech postaci. Kopie obiektu współdzielą
+// niezmienne dane współrzędnych, łuków rzadkich i macierzy.
+class DistanceProvider {
+public:
+    enum class Storage {
+        Auto,
+        Dense,
+        Coordinates,
+        Sparse
+    };
+
+    // Nazwy postaci: AUTO, DENSE, COORDINATES, SPARSE (nieznana nazwa - AUTO)
+    static Storage storageFromName(const string& name);
+
+    static const char* storageName(Storage storage);
+
+    // Przełączenie na pełną macierz - zwracana jest macierz do wypełnienia lub wczytania
+    DistanceMatrix& useMatrix();
+
+    void useCoordinates(int newDimension, vector<double> x, vector<double> y, CoordinateMetric metric);
+
+    void useSparse(int newDimension, vector<int> offsets, vector<int> targets, vector<int> weights, int penalty);
+
+    void clear();
+
+    Storage storage() const {
+        return kind;
+    }
+
+    int dimension() const {
+        return kind == Storage::Dense ? denseMatrix.dimension() : V;
+    }
+
+    bool empty() const {
+        return dimension() == 0;
+    }
+
+    const DistanceMatrix& matrix() const {
+        return denseMatrix;
+    }
+
+    CoordinateDistances coordinates() const;
+
+    SparseDistances sparse() const;
+
+    // Odczyt odległości poza pętlami algorytmu (rozgałęzienie na postać danych)
+    int operator()(int from, int to) const;
+
+    // Górne ograniczenie wartości bezwzględnej kosztu dowolnej trasy
+    long long tourCostBound() const;
+
+    // Szerokość przechowywanej odległości w bitach (odległości liczone na bieżąco - 32)
+    int distanceBits() const;
+
+    // Pamięć zajmowana przez dane odległości w bajtach
+    size_t byteSize() const;
+
+    // Wywołanie funkcji z widokiem odpowiednim dla postaci danych
+    template<typename Function>
+    auto visit(Function&& function) const {
+        switch (kind) {
+            case Storage::Coordinates:
+                return function(coordinates());
+            case Storage::Sparse:
+                return function(sparse());
+            default:
+                if (denseMatrix.elementWidth() == sizeof(int16_t)) {
+                    return function(denseMatrix.view<int16_t>());
+                }
+                return function(denseMatrix.view<int32_t>());
+        }
+    }
+
+    // Widok o typie znanym w czasie kompilacji (zgodnym z postacią danych)
+    template<typename View>
+    View view() const {
+        if constexpr (is_same_v<View, CoordinateDistances>) {
+            return coordinates();
+        } else if constexpr (is_same_v<View, SparseDistances>) {
+            return sparse();
+        } else {
+            return denseMatrix.view<typename View::Element>();
+        }
+    }
+
+private:
+    struct CoordinateData {
+        vector<double> x;
+        vector<double> y;
+        CoordinateMetric metric = CoordinateMetric::Euclidean;
+    };
+
+    struct SparseData {
+        vector<int> offsets;
+        vector<int> targets;
+        vector<int> weights;
+        int penalty = 0;
+    };
+
+    Storage kind = Storage::Dense;
+
+    // Liczba miast dla współrzędnych i łuków rzadkich (pełna macierz przechowuje własny rozmiar)
+    int V = 0;
+
+    DistanceMatrix denseMatrix;
+    shared_ptr<const CoordinateData> coordinateData;
+    shared_ptr<const SparseData> sparseData;
+};
+
+// Wybór postaci danych przy wczytywaniu instancji. AUTO wybiera pełną macierz, jeśli mieści się
+// w limicie pamięci, a w przeciwnym razie współrzędne (instancje geometryczne) lub łuki rzadkie.
+struct DistanceOptions {
+    DistanceProvider::Storage storage = DistanceProvider::Storage::Auto;
+
+    // Limit pamięci pełnej macierzy w bajtach (liczony dla elementów 32-bitowych)
+    size_t matrixMemoryLimit = size_t(1) << 30;
+
+    // Liczba zapamiętanych łuków wychodzących z miasta w postaci rzadkiej
+    int sparseNeighbours = 16;
+
+    // Koszt łuku spoza zbioru rzadkiego (0 - największa odległość w instancji)
+    int sparsePenalty = 0;
+
+    bool denseFits(int V) const {
+        return static_cast<size_t>(V) * V * sizeof(int32_t) <= matrixMemoryLimit;
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_DISTANCEPROVIDER_H
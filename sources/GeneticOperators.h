@@ -0,0 +1,263 @@
+#ifndef GENETIC_ALGORITHM_GENETICOPERATORS_H
+#define GENETIC_ALGORITHM_GENETICOPERATORS_H
+
+
+#include <utility>
+
+#include "CrossoverScratch.h"
+#include "DistanceMatrix.h"
+#include "Moves.h"
+#include "PopulationArena.h"
+#include "Random.h"
+#include "Selection.h"
+#include "Succession.h"
+
+using namespace std;
+
+// Operatory genetyczne w postaci polityk - typów będących parametrami szablonu pokolenia
+// (ATSP::evolveGeneration). Wybór operatorów na podstawie parametrów tekstowych odbywa się raz
+// przed rozpoczęciem obliczeń, a metody polityk są statyczne i zdefiniowane w nagłówku, więc
+// kompilator może je rozwinąć w pętli pokolenia.
+// Parametr FixedDimension > 0 ustala rozmiar problemu w czasie kompilacji (pętle o stałej liczbie
+// iteracji), wartość 0 oznacza rozmiar V podany w czasie wykonania. Typ genu (Gene) i typ widoku
+// macierzy odległości (Distances) wynikają z wczytanej instancji.
+
+template<int FixedDimension>
+inline int problemSize(int V) {
+    return FixedDimension > 0 ? FixedDimension : V;
+}
+
+// Krzyżowanie OX (Order Crossover)
+struct OrderCrossover {
+    static constexpr const char* name = "OX";
+
+    // Potomek child1 z rodziców (P1, P2) oraz child2 z rodziców (P2, P1), jeśli child2 != nullptr
+    template<int FixedDimension, typename Gene>
+    static void cross(int V, const Gene* parent1, const Gene* parent2, Gene* child1, Gene* child2,
+                      CrossoverScratch& scratch, Random& random) {
+        offspring<FixedDimension>(V, parent1, parent2, child1, scratch, random);
+        if (child2 != nullptr) {
+            offspring<FixedDimension>(V, parent2, parent1, child2, scratch, random);
+        }
+    }
+
+    // Potomek zapisywany jest do bufora child. Obecność genów w potomku sprawdzana jest
+    // w mapie bitowej, więc krzyżowanie ma złożoność O(n)
+    template<int FixedDimension, typename Gene>
+    static void offspring(int V, const Gene* parent1, const Gene* parent2, Gene* child, CrossoverScratch& scratch,
+                          Random& random) {
+
+        const int size = problemSize<FixedDimension>(V);
+
+        // Wygeneruj dwa punkty cięcia losowo
+        int cuttingPoint1 = random.nextInt(0, size - 1);
+        int cuttingPoint2 = random.nextInt(0, size - 1);
+
+        // Upewnij się, że punkty cięcia są różne
+        while (cuttingPoint1 == cuttingPoint2) {
+            cuttingPoint2 = random.nextInt(0, size - 1);
+        }
+
+        // Upewnij się, że cuttingPoint1 < cuttingPoint2
+        if (cuttingPoint1 > cuttingPoint2) {
+            swap(cuttingPoint1, cuttingPoint2);
+        }
+
+        // Skopiuj segment od rodzica P1 do potomka i oznacz jego geny jako obecne
+        scratch.clearPresent();
+        for (int i = cuttingPoint1; i <= cuttingPoint2; i++) {
+            child[i] = parent1[i];
+            scratch.markPresent(parent1[i]);
+        }
+
+        // Wypełnij resztę potomka genami z rodzica P2 w kolejności, pomijając istniejące geny
+        int index = (cuttingPoint2 + 1) % size;
+
+        // Sprawdź każdy gen z rodzica P2 w kolejności (od pozycji za drugim punktem cięcia)
+        int source = index;
+        for (int i = 0; i < size; i++) {
+            const Gene gene = parent2[source];
+
+            if (!scratch.isPresent(gene)) {
+                child[index] = gene;
+                index = index + 1 == size ? 0 : index + 1;
+            }
+            source = source + 1 == size ? 0 : source + 1;
+        }
+    }
+};
+
+// Krzyżowanie PMX (Partially Matched Crossover) - potomkowie zapisywani są do buforów
+// child1 (segment rodzica P2, reszta z P1) i child2 (segment P1, reszta z P2; może być nullptr).
+// Zamiast łańcuchów odwzorowań genów wykonywane są zamiany z użyciem tablic pozycji, co daje O(n)
+struct PartiallyMatchedCrossover {
+    static constexpr const char* name = "PMX";
+
+    template<int FixedDimension, typename Gene>
+    static void cross(int V, const Gene* parent1, const Gene* parent2, Gene* child1, Gene* child2,
+                      CrossoverScratch& scratch, Random& random) {
+
+        const int size = problemSize<FixedDimension>(V);
+        int* position1 = scratch.position1.data();
+        int* position2 = scratch.position2.data();
+
+        // Potomkowie inicjalizowani genami rodziców wraz z tablicami pozycji genów
+        for (int i = 0; i < size; i++) {
+            child1[i] = parent1[i];
+            position1[parent1[i]] = i;
+        }
+        if (child2 != nullptr) {
+            for (int i = 0; i < size; i++) {
+                child2[i] = parent2[i];
+                position2[parent2[i]] = i;
+            }
+        }
+
+        // Wygeneruj dwa punkty cięcia losowo
+        int cuttingPoint1 = random.nextInt(0, size - 1);
+        int cuttingPoint2 = random.nextInt(0, size - 1);
+
+        // Upewnij się, że punkty cięcia są różne
+        while (cuttingPoint1 == cuttingPoint2) {
+            cuttingPoint2 = random.nextInt(0, size - 1);
+        }
+
+        // Ustaw punkt początkowy i końcowy dla krzyżowania
+        if (cuttingPoint1 > cuttingPoint2) {
+            swap(cuttingPoint1, cuttingPoint2);
+        }
+
+        // Wstawienie genu z segmentu drugiego rodzica na pozycję i - gen wypierany z tej pozycji
+        // trafia na dotychczasowe miejsce wstawianego genu (odpowiednik podążania za odwzorowaniem)
+        for (int i = cuttingPoint1; i < cuttingPoint2; ++i) {
+            const Gene gene1 = parent1[i];
+            const Gene gene2 = parent2[i];
+
+            const int from1 = position1[gene2];
+            swap(child1[i], child1[from1]);
+            position1[child1[from1]] = from1;
+            position1[gene2] = i;
+
+            if (child2 != nullptr) {
+                const int from2 = position2[gene1];
+                swap(child2[i], child2[from2]);
+                position2[child2[from2]] = from2;
+                position2[gene1] = i;
+            }
+        }
+    }
+};
+
+// Mutacja przez wstawienie (Insertion Mutation). Jeśli koszt osobnika jest aktualny,
+// zostaje on uaktualniony o zmianę kosztu ruchu (trzy łuki) zamiast ponownego obliczania
+struct InsertionMutation {
+    static constexpr const char* name = "INSERTION";
+
+    template<int FixedDimension, typename Gene, typename Distances>
+    static void mutate(const Distances& matrix, const TourHash& hashes, PopulationArena& arena, int slot,
+                       Random& random) {
+
+        const int size = problemSize<FixedDimension>(matrix.dimension());
+
+        // Wybierz dwa punkty mutacji losowo
+        int mutationPoint1 = random.nextInt(0, size - 1);
+        int mutationPoint2 = random.nextInt(0, size - 1);
+
+        // Upewnij się, że punkty mutacji są różne
+        while (mutationPoint1 == mutationPoint2) {
+            mutationPoint2 = random.nextInt(0, size - 1);
+        }
+
+        // Przeniesienie genu z punktu mutacji 1 do punktu mutacji 2 (przesunięcie genów pomiędzy nimi)
+        const SegmentMove move = SegmentMove::insertion(mutationPoint1, mutationPoint2);
+
+        Gene* tour = arena.genes<Gene>(slot);
+        if (!arena.isDirty(slot)) {
+            arena.cost(slot) += move.delta(matrix, tour);
+        }
+
+        // Skrót trasy (o ile był obliczony) uaktualniany jest tak samo jak koszt, w czasie O(1)
+        if (arena.hasHash(slot)) {
+            arena.setHash(slot, arena.hash(slot) ^ move.hashDelta(hashes, tour, size));
+        }
+        move.apply(tour);
+    }
+};
+
+// Mutacja przez zamianę (Swap Mutation) - dwa losowe geny zamieniane są miejscami. Koszt
+// i skrót osobnika uaktualniane są tak jak w mutacji przez wstawienie (do czterech łuków)
+struct SwapMutation {
+    static constexpr const char* name = "SWAP";
+
+    template<int FixedDimension, typename Gene, typename Distances>
+    static void mutate(const Distances& matrix, const TourHash& hashes, PopulationArena& arena, int slot,
+                       Random& random) {
+
+        const int size = problemSize<FixedDimension>(matrix.dimension());
+
+        int mutationPoint1 = random.nextInt(0, size - 1);
+        int mutationPoint2 = random.nextInt(0, size - 1);
+
+        while (mutationPoint1 == mutationPoint2) {
+            mutationPoint2 = random.nextInt(0, size - 1);
+        }
+
+        const SwapMove move{mutationPoint1, mutationPoint2};
+
+        Gene* tour = arena.genes<Gene>(slot);
+        if (!arena.isDirty(slot)) {
+            arena.cost(slot) += move.delta(matrix, tour);
+        }
+        if (arena.hasHash(slot)) {
+            arena.setHash(slot, arena.hash(slot) ^ move.hashDelta(hashes, tour, size));
+        }
+        move.apply(tour);
+    }
+};
+
+// Polityki selekcji - metoda przygotowania struktur w Selection i bezpośrednie wywołanie losowania
+struct RouletteSelection {
+    static constexpr Selection::Method method = Selection::Method::Roulette;
+
+    static int select(const Selection& selection, Random& random) {
+        return selection.rouletteWheel(random);
+    }
+};
+
+struct BinarySearchSelection {
+    static constexpr Selection::Method method = Selection::Method::BinarySearch;
+
+    static int select(const Selection& selection, Random& random) {
+        return selection.binarySearchRoulette(random);
+    }
+};
+
+struct AliasSelection {
+    static constexpr Selection::Method method = Selection::Method::Alias;
+
+    static int select(const Selection& selection, Random& random) {
+        return selection.aliasMethod(random);
+    }
+};
+
+struct TournamentSelection {
+    static constexpr Selection::Method method = Selection::Method::Tournament;
+
+    static int select(const Selection& selection, Random& random) {
+        return selection.tournament(random);
+    }
+};
+
+// Polityki sukcesji (wykonywanej raz na pokolenie, więc wystarczy stała strategii)
+template<Succession::Policy SuccessionPolicy>
+struct SuccessionStrategy {
+    static constexpr Succession::Policy policy = SuccessionPolicy;
+};
+
+using ParentsSuccession = SuccessionStrategy<Succession::Policy::Parents>;
+using PlusSuccession = SuccessionStrategy<Succession::Policy::Plus>;
+using CommaSuccession = SuccessionStrategy<Succession::Policy::Comma>;
+using SteadySuccession = SuccessionStrategy<Succession::Policy::Steady>;
+
+
+#endif //GENETIC_ALGORITHM_GENETICOPERATORS_H
@@ -0,0 +1,28 @@
+#ifndef GENETIC_ALGORITHM_INDIVIDUAL_H
+#define GENETIC_ALGORITHM_INDIVIDUAL_H
+
+
+#include <vector>
+
+using namespace std;
+
+// Osobnik populacji - trasa (chromosom) wraz z zapamiętanym kosztem.
+// Flaga dirty oznacza, że chromosom został zmieniony (krzyżowanie, mutacja)
+// i koszt musi zostać obliczony ponownie przed jego odczytem.
+struct Individual {
+    vector<int> chromosome;
+    int cost = 0;
+    bool dirty = true;
+
+    Individual() = default;
+
+    explicit Individual(vector<int> newChromosome) : chromosome(std::move(newChromosome)) {}
+
+    // Oznaczenie chromosomu jako zmienionego
+    void markDirty() {
+        dirty = true;
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_INDIVIDUAL_H
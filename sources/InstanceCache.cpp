@@ -0,0 +1,112 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "InstanceCache.h"
+
+namespace {
+
+    const char Magic[8] = {'A', 'T', 'S', 'P', 'B', 'I', 'N', '\0'};
+
+    // Znacznik kolejności bajtów - kopia zapisana na maszynie o innej kolejności jest odrzucana
+    const uint32_t ByteOrderMark = 0x01020304;
+
+    // Rozmiar i czas modyfikacji pliku źródłowego
+    bool sourceStamp(const string& sourceFileName, uint64_t& size, int64_t& time) {
+        error_code error;
+        size = filesystem::file_size(sourceFileName, error);
+        if (error) {
+            return false;
+        }
+        filesystem::file_time_type writeTime = filesystem::last_write_time(sourceFileName, error);
+        if (error) {
+            return false;
+        }
+        time = static_cast<int64_t>(writeTime.time_since_epoch().count());
+        return true;
+    }
+
+    bool validHeader(const InstanceCacheHeader& header) {
+        return memcmp(header.magic, Magic, sizeof(Magic)) == 0 &&
+               header.version == InstanceCache::Version &&
+               header.byteOrder == ByteOrderMark &&
+               (header.elementWidth == sizeof(int16_t) || header.elementWidth == sizeof(int32_t));
+    }
+}
+
+string InstanceCache::cacheFileName(const string& sourceFileName) {
+    return sourceFileName + ".bin";
+}
+
+bool InstanceCache::isCacheFile(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    char magic[sizeof(Magic)];
+    return file.read(magic, sizeof(magic)) && memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+bool InstanceCache::load(const string& fileName, const string& sourceFileName, DistanceMatrix& matrix) {
+    auto file = make_shared<MappedFile>();
+    if (!file->open(fileName, true, MappedFile::Access::Random) || file->size() < sizeof(InstanceCacheHeader)) {
+        return false;
+    }
+
+    InstanceCacheHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+    if (!validHeader(header) || header.dimension < 2) {
+        return false;
+    }
+
+    const size_t matrixBytes = static_cast<size_t>(header.dimension) * header.dimension * header.elementWidth;
+    if (file->size() != sizeof(header) + matrixBytes) {
+        return false;
+    }
+
+    // Kopia jest nieaktualna, jeśli plik źródłowy zmienił się od czasu jej zapisu
+    if (!sourceFileName.empty()) {
+        uint64_t size;
+        int64_t time;
+        if (!sourceStamp(sourceFileName, size, time) || size != header.sourceSize || time != header.sourceTime) {
+            return false;
+        }
+    }
+
+    matrix.attach(std::move(file), sizeof(header), static_cast<int>(header.dimension),
+                  static_cast<int>(header.elementWidth));
+    return true;
+}
+
+bool InstanceCache::save(const string& fileName, const string& sourceFileName, const DistanceMatrix& matrix) {
+    InstanceCacheHeader header{};
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byteOrder = ByteOrderMark;
+    header.dimension = static_cast<uint32_t>(matrix.dimension());
+    header.elementWidth = static_cast<uint32_t>(matrix.elementWidth());
+    if (!sourceStamp(sourceFileName, header.sourceSize, header.sourceTime)) {
+        return false;
+    }
+
+    const string temporaryFileName = fileName + ".tmp";
+    {
+        ofstream file(temporaryFileName, ios::binary | ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(matrix.bytes()), static_cast<streamsize>(matrix.byteSize()));
+        if (!file) {
+            file.close();
+            error_code error;
+            filesystem::remove(temporaryFileName, error);
+            return false;
+        }
+    }
+
+    error_code error;
+    filesystem::rename(temporaryFileName, fileName, error);
+    if (error) {
+        filesystem::remove(temporaryFileName, error);
+        return false;
+    }
+    return true;
+}
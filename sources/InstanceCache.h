@@ -0,0 +1,49 @@
+#ifndef GENETIC_ALGORITHM_INSTANCECACHE_H
+#define GENETIC_ALGORITHM_INSTANCECACHE_H
+
+
+#include <cstdint>
+#include <string>
+
+#include "DistanceMatrix.h"
+
+using namespace std;
+
+// Nagłówek binarnej kopii instancji (64 bajty, więc macierz zaczyna się na granicy linii pamięci
+// podręcznej). Rozmiar i czas modyfikacji pliku źródłowego pozwalają wykryć nieaktualną kopię.
+struct InstanceCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t dimension;
+    uint32_t elementWidth;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint8_t reserved[24];
+};
+
+static_assert(sizeof(InstanceCacheHeader) == 64, "Naglowek musi zajmowac jedna linie pamieci podrecznej");
+
+// Binarna kopia macierzy odległości: nagłówek, a po nim surowa macierz (V * V elementów
+// o szerokości elementWidth bajtów, wierszami). Plik wczytywany jest bez parsowania i kopiowania - macierz korzysta bezpośrednio
+// z pliku odwzorowanego w pamięci. Kopia (plik .bin obok pliku .atsp) zapisywana jest przy
+// pierwszym parsowaniu instancji i używana przy kolejnych wczytaniach.
+class InstanceCache {
+public:
+    static constexpr uint32_t Version = 1;
+
+    // Nazwa pliku z binarną kopią dla danego pliku TSPLIB
+    static string cacheFileName(const string& sourceFileName);
+
+    // Sprawdzenie, czy plik jest binarną kopią instancji (na podstawie sygnatury)
+    static bool isCacheFile(const string& fileName);
+
+    // Wczytanie binarnej kopii; jeśli sourceFileName nie jest pusty, kopia musi być z nim zgodna
+    static bool load(const string& fileName, const string& sourceFileName, DistanceMatrix& matrix);
+
+    // Zapis binarnej kopii macierzy (przez plik tymczasowy, więc przerwany zapis nie psuje kopii)
+    static bool save(const string& fileName, const string& sourceFileName, const DistanceMatrix& matrix);
+};
+
+
+#endif //GENETIC_ALGORITHM_INSTANCECACHE_H
@@ -15,6 +15,21 @@ void Interface::menu() {
     string crossingMethod;
     string crossoverRate;
     string mutationRate;
+    string seed;
+    string threadCount;
+    string islandCount;
+    string migrationInterval;
+    string migrantCount;
+    string migrationTopology;
+    string selectionMethod;
+    string tournamentSize;
+    string successionPolicy;
+    string replacementCount;
+    string localSearchMode;
+    string checkpointFile;
+    string checkpointInterval;
+    string traceFile;
+    string traceInterval;
 
     do {
 
@@ -41,7 +56,9 @@ void Interface::menu() {
                 // na stronie: http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/atsp/
                 cout << "Podaj nazwe pliku wraz z rozszerzeniem (np. ftv47.atsp):";
                 cin >> fileName;
-                atsp.loadATSPFile(fileName);
+                if (!atsp.loadATSPFile(fileName)) {
+                    cerr << "ERROR while loading the file: " << atsp.loadError() << endl;
+                }
                 break;
 
             case '2':
@@ -52,6 +69,10 @@ void Interface::menu() {
             case '3':
                 char parameterMenuOption;
                 char crossingMethodOption;
+                char topologyOption;
+                char selectionMethodOption;
+                char successionPolicyOption;
+                char localSearchOption;
 
                 do {
                     cout << endl << "\n-----USTAWIENIE PARAMETROW-----\n";
@@ -60,6 +81,14 @@ void Interface::menu() {
                     cout << "[3] Metoda krzyzowania\n";
                     cout << "[4] Wspolczynnik krzyzowania\n";
                     cout << "[5] Wspolczynnik mutacji\n";
+                    cout << "[6] Ziarno generatora liczb losowych\n";
+                    cout << "[7] Liczba watkow\n";
+                    cout << "[8] Model wyspowy\n";
+                    cout << "[9] Metoda selekcji\n";
+                    cout << "[a] Strategia sukcesji\n";
+                    cout << "[b] Przeszukiwanie lokalne potomstwa\n";
+                    cout << "[c] Punkt kontrolny\n";
+                    cout << "[d] Zapis przebiegu zbieznosci\n";
                     cout << "[0] Wyjscie\n";
 
                     cout << "Twoj wybor:";
@@ -109,6 +138,125 @@ void Interface::menu() {
                             cin >> mutationRate;
                             break;
 
+                        case '6':
+                            cout << "\nOpcja 6: Ziarno generatora liczb losowych\n";
+                            // Ustalone ziarno pozwala powtórzyć przebieg algorytmu (np. w testach regresji)
+                            cout << "Podaj ziarno (np. 12345):";
+                            cin >> seed;
+                            break;
+
+                        case '7':
+                            cout << "\nOpcja 7: Liczba watkow\n";
+                            cout << "Podaj liczbe watkow (np. 8, 0 - wszystkie dostepne):";
+                            cin >> threadCount;
+                            break;
+
+                        case '8':
+                            cout << "\nOpcja 8: Model wyspowy\n";
+                            cout << "Podaj liczbe wysp (np. 8, 1 - jedna populacja):";
+                            cin >> islandCount;
+                            cout << "Podaj co ile pokolen nastepuje migracja (np. 50):";
+                            cin >> migrationInterval;
+                            cout << "Podaj liczbe migrujacych osobnikow (np. 2):";
+                            cin >> migrantCount;
+                            cout << "[1] Topologia pierscienia\n";
+                            cout << "[2] Topologia pelna\n";
+                            cout << "[3] Topologia losowa\n";
+
+                            cout << "Twoj wybor (np. 1):";
+                            cin >> topologyOption;
+
+                            if (topologyOption == '1') {
+                                migrationTopology = "RING";
+                            } else if (topologyOption == '2') {
+                                migrationTopology = "FULL";
+                            } else if (topologyOption == '3') {
+                                migrationTopology = "RANDOM";
+                            }
+                            break;
+
+                        case '9':
+                            cout << "\nOpcja 9: Metoda selekcji\n";
+                            cout << "[1] Kolo ruletki (przeszukiwanie liniowe)\n";
+                            cout << "[2] Kolo ruletki (wyszukiwanie binarne)\n";
+                            cout << "[3] Metoda aliasow\n";
+                            cout << "[4] Selekcja turniejowa\n";
+
+                            cout << "Twoj wybor (np. 1):";
+                            cin >> selectionMethodOption;
+
+                            if (selectionMethodOption == '1') {
+                                selectionMethod = "RW";
+                            } else if (selectionMethodOption == '2') {
+                                selectionMethod = "BS";
+                            } else if (selectionMethodOption == '3') {
+                                selectionMethod = "ALIAS";
+                            } else if (selectionMethodOption == '4') {
+                                selectionMethod = "TOUR";
+                                cout << "Podaj rozmiar turnieju (np. 3):";
+                                cin >> tournamentSize;
+                            }
+                            break;
+
+                        case 'a':
+                            cout << "\nOpcja a: Strategia sukcesji\n";
+                            cout << "[1] Najlepsze z rodzicow i potomstwa\n";
+                            cout << "[2] Elitarna (mu + lambda)\n";
+                            cout << "[3] Pokoleniowa (mu, lambda)\n";
+                            cout << "[4] Stacjonarna (steady-state)\n";
+
+                            cout << "Twoj wybor (np. 1):";
+                            cin >> successionPolicyOption;
+
+                            if (successionPolicyOption == '1') {
+                                successionPolicy = "PARENTS";
+                            } else if (successionPolicyOption == '2') {
+                                successionPolicy = "PLUS";
+                            } else if (successionPolicyOption == '3') {
+                                successionPolicy = "COMMA";
+                            } else if (successionPolicyOption == '4') {
+                                successionPolicy = "STEADY";
+                                cout << "Podaj liczbe wymienianych osobnikow w pokoleniu (np. 10):";
+                                cin >> replacementCount;
+                            }
+                            break;
+
+                        case 'b':
+                            cout << "\nOpcja b: Przeszukiwanie lokalne potomstwa (Or-opt i 3-opt)\n";
+                            cout << "[1] Wylaczone\n";
+                            cout << "[2] Tylko najlepszy potomek\n";
+                            cout << "[3] Wszyscy potomkowie\n";
+
+                            cout << "Twoj wybor (np. 1):";
+                            cin >> localSearchOption;
+
+                            if (localSearchOption == '1') {
+                                localSearchMode = "OFF";
+                            } else if (localSearchOption == '2') {
+                                localSearchMode = "BEST";
+                            } else if (localSearchOption == '3') {
+                                localSearchMode = "ALL";
+                            }
+                            break;
+
+                        case 'c':
+                            cout << "\nOpcja c: Punkt kontrolny\n";
+                            // Istniejący plik punktu kontrolnego zgodny z instancją i parametrami wznawia obliczenia
+                            cout << "Podaj nazwe pliku punktu kontrolnego (np. ftv47.chk):";
+                            cin >> checkpointFile;
+                            cout << "Podaj co ile pokolen zapisywany jest stan (np. 1000):";
+                            cin >> checkpointInterval;
+                            break;
+
+                        case 'd':
+                            cout << "\nOpcja d: Zapis przebiegu zbieznosci\n";
+                            // Rozszerzenie .json wybiera format JSON, pozostałe - CSV
+                            cout << "Podaj nazwe pliku (np. przebieg.csv lub przebieg.json):";
+                            cin >> traceFile;
+                            cout << "Podaj co ile pokolen zapisywany jest punkt przebiegu (np. 10):";
+                            cin >> traceInterval;
+                            break;
+
                         default:
                             cout << "\nPodana opcja nie istnieje!\n";
                             break;
@@ -124,13 +272,33 @@ void Interface::menu() {
                 cout << "Kryterium stopu: " << maxExecutionTime << "s" << endl;
                 cout << "Wielkosc populacji: " << populationSize << endl;
                 cout << "Metoda krzyzowania: " << crossingMethod << endl;
+                cout << "Metoda selekcji: " << (selectionMethod.empty() ? "RW" : selectionMethod) << endl;
+                cout << "Strategia sukcesji: " << (successionPolicy.empty() ? "PARENTS" : successionPolicy) << endl;
+                cout << "Przeszukiwanie lokalne: " << (localSearchMode.empty() ? "OFF" : localSearchMode) << endl;
                 cout << "Wspolczynnik krzyzowania: " << crossoverRate << endl;
                 cout << "Metoda mutacji: Insertion" << endl;
                 cout << "Wspolczynnik mutacji: " << mutationRate << endl;
+                cout << "Ziarno generatora: " << (seed.empty() ? "losowe" : seed) << endl;
+                cout << "Liczba watkow: " << (threadCount.empty() ? "1" : threadCount) << endl;
+                if (!islandCount.empty() && islandCount != "1") {
+                    cout << "Liczba wysp: " << islandCount << endl;
+                    cout << "Interwal migracji: " << migrationInterval << endl;
+                    cout << "Liczba migrantow: " << migrantCount << endl;
+                    cout << "Topologia migracji: " << (migrationTopology.empty() ? "RING" : migrationTopology) << endl;
+                }
+                if (!checkpointFile.empty()) {
+                    cout << "Punkt kontrolny: " << checkpointFile << endl;
+                }
+                if (!traceFile.empty()) {
+                    cout << "Przebieg zbieznosci: " << traceFile << endl;
+                }
                 cout << "--------------------------------" << endl;
 
-                atsp.geneticAlgorithm(fileName, crossingMethod, maxExecutionTime, populationSize, crossoverRate,
-                                      mutationRate);
+                atsp.geneticAlgorithm(crossingMethod, maxExecutionTime, populationSize, crossoverRate, mutationRate,
+                                      seed, threadCount, islandCount, migrationInterval, migrantCount,
+                                      migrationTopology, selectionMethod, tournamentSize, successionPolicy,
+                                      replacementCount, localSearchMode, checkpointFile, checkpointInterval, traceFile,
+                                      traceInterval);
                 break;
 
             default:
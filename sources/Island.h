@@ -0,0 +1,74 @@
+#ifndef GENETIC_ALGORITHM_ISLAND_H
+#define GENETIC_ALGORITHM_ISLAND_H
+
+
+#include <mutex>
+#include <vector>
+
+#include "CrossoverScratch.h"
+#include "Individual.h"
+#include "LocalSearch.h"
+#include "PopulationArena.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "Selection.h"
+#include "Succession.h"
+#include "TourHash.h"
+
+using namespace std;
+
+// Stan jednej populacji algorytmu genetycznego. W trybie jednej populacji istnieje
+// dokładnie jedna wyspa, a w modelu wyspowym każda wyspa ewoluuje w osobnym wątku
+// i okresowo wymienia najlepsze osobniki z innymi wyspami (migracja).
+struct Island {
+    // Arena z chromosomami bieżącego pokolenia, następnego pokolenia i potomstwa
+    PopulationArena arena;
+
+    // Indeksy rodziców wybranych z bieżącego pokolenia
+    vector<int> parents;
+
+    // Sukcesja (wybór osobników do następnego pokolenia)
+    Succession succession;
+
+    // Struktury selekcji rodziców przygotowywane raz na pokolenie
+    Selection selection;
+
+    // Strumienie liczb losowych (po jednym na wątek roboczy wyspy)
+    vector<Random> randoms;
+
+    // Bufory pomocnicze operatorów krzyżowania (po jednym na wątek roboczy)
+    vector<CrossoverScratch> scratch;
+
+    // Przeszukiwanie lokalne potomstwa (po jednym na wątek roboczy, puste przy wyłączonym)
+    vector<LocalSearch> localSearches;
+
+    // Najlepszy osobnik znaleziony na wyspie
+    Individual bestIndividual;
+
+    // Liczba wykonanych pokoleń i pokolenie ostatniej poprawy najlepszej trasy
+    long long generation = 0;
+    long long improvementGeneration = 0;
+
+    // Skrzynka odbiorcza migrantów przesłanych przez inne wyspy (inboxCount pierwszych
+    // elementów jest aktualnych, pozostałe przechowują pamięć do ponownego wykorzystania)
+    mutex inboxMutex;
+    vector<Individual> inbox;
+    int inboxCount = 0;
+
+    // Numery wysp docelowych migracji
+    vector<int> migrationTargets;
+
+    // Liczba obliczeń kosztu (po jednym liczniku na wątek roboczy)
+    vector<long long> evaluationCounts;
+
+    // Pamięć kosztów tras odwiedzonych przez wątek roboczy i liczba obliczeń kosztu, które
+    // zastąpiła (po jednej na wątek roboczy)
+    vector<CostCache> costCaches;
+    vector<long long> cacheHits;
+
+    // Pomiary czasu etapów pokolenia (aktywne tylko przy GA_PROFILING)
+    Profiler profiler;
+};
+
+
+#endif //GENETIC_ALGORITHM_ISLAND_H
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <numeric>
+
+#include "LocalSearch.h"
+#include "Moves.h"
+
+// Budowa list k najbliższych poprzedników i następników każdego miasta. Dla pełnej macierzy
+// przeglądane są wszystkie łuki, dla współrzędnych listy pochodzą z wyszukiwania w siatce
+// (odległości symetryczne), a dla łuków rzadkich - z zapamiętanych łuków
+void CandidateLists::build(const DistanceProvider& distances, int newSize) {
+    const int V = distances.dimension();
+    k = max(1, min(newSize, V - 1));
+
+    if (distances.storage() == DistanceProvider::Storage::Coordinates) {
+        distances.coordinates().nearestNeighbours(k, successors);
+        predecessors = successors;
+        return;
+    }
+    if (distances.storage() == DistanceProvider::Storage::Sparse) {
+        buildSparse(distances.sparse());
+        return;
+    }
+
+    const DistanceMatrix& matrix = distances.matrix();
+    predecessors.assign(static_cast<size_t>(V) * k, 0);
+    successors.assign(static_cast<size_t>(V) * k, 0);
+
+    vector<int> cities;
+    for (int city = 0; city < V; city++) {
+        // Najtańsze łuki wychodzące z miasta
+        cities.resize(V);
+        iota(cities.begin(), cities.end(), 0);
+        cities.erase(cities.begin() + city);
+        partial_sort(cities.begin(), cities.begin() + k, cities.end(), [&](int a, int b) {
+            return matrix(city, a) < matrix(city, b);
+        });
+        copy(cities.begin(), cities.begin() + k, successors.begin() + static_cast<size_t>(city) * k);
+
+        // Najtańsze łuki wchodzące do miasta
+        cities.resize(V);
+        iota(cities.begin(), cities.end(), 0);
+        cities.erase(cities.begin() + city);
+        partial_sort(cities.begin(), cities.begin() + k, cities.end(), [&](int a, int b) {
+            return matrix(a, city) < matrix(b, city);
+        });
+        copy(cities.begin(), cities.begin() + k, predecessors.begin() + static_cast<size_t>(city) * k);
+    }
+}
+
+// Listy z łuków rzadkich: następnicy to początek (najtańsze łuki) listy łuków miasta, poprzednicy -
+// najtańsze zapamiętane łuki wchodzące, uzupełnione następnikami, jeśli łuków wchodzących jest za mało
+void CandidateLists::buildSparse(const SparseDistances& sparse) {
+    const int V = sparse.dimension();
+    for (int city = 0; city < V; city++) {
+        k = min(k, sparse.offsets[city + 1] - sparse.offsets[city]);
+    }
+    k = max(k, 0);
+
+    predecessors.assign(static_cast<size_t>(V) * k, 0);
+    successors.assign(static_cast<size_t>(V) * k, 0);
+
+    // Łuki wchodzące (koszt, miasto początkowe) dla każdego miasta
+    vector<vector<pair<int, int>>> incoming(V);
+    for (int from = 0; from < V; from++) {
+        for (int i = sparse.offsets[from]; i < sparse.offsets[from + 1]; i++) {
+            incoming[sparse.targets[i]].emplace_back(sparse.weights[i], from);
+        }
+        copy(sparse.targets + sparse.offsets[from], sparse.targets + sparse.offsets[from] + k,
+             successors.begin() + static_cast<size_t>(from) * k);
+    }
+
+    for (int city = 0; city < V; city++) {
+        vector<pair<int, int>>& arcs = incoming[city];
+        sort(arcs.begin(), arcs.end());
+
+        int* list = predecessors.data() + static_cast<size_t>(city) * k;
+        int count = 0;
+        for (size_t i = 0; i < arcs.size() && count < k; i++) {
+            list[count++] = arcs[i].second;
+        }
+        const int* cityOutgoing = nearestSuccessors(city);
+        for (int i = 0; i < k && count < k; i++) {
+            if (find(list, list + count, cityOutgoing[i]) == list + count) {
+                list[count++] = cityOutgoing[i];
+            }
+        }
+        for (int other = (city + 1) % V; count < k; other = (other + 1) % V) {
+            if (other != city && find(list, list + count, other) == list + count) {
+                list[count++] = other;
+            }
+        }
+        vector<pair<int, int>>().swap(arcs);
+    }
+}
+
+void LocalSearch::prepare(int newV, int newMaxSegmentLength) {
+    V = newV;
+    maxSegmentLength = newMaxSegmentLength;
+    position.assign(V, 0);
+    dontLook.assign(V, 1);
+    queue.assign(V, 0);
+}
+
+template<typename Distances, typename Gene>
+int LocalSearch::improve(const Distances& matrix, const CandidateLists& candidates, Gene* tour, int cost) {
+
+    if (V < 5) {
+        return cost;
+    }
+
+    // Na początku wszystkie miasta są aktywne (w kolejności trasy)
+    queueHead = 0;
+    queueSize = 0;
+    for (int i = 0; i < V; i++) {
+        position[tour[i]] = i;
+        activate(tour[i]);
+    }
+
+    // Przetwarzanie aktywnych miast do momentu, gdy żaden ruch nie poprawia trasy
+    while (queueSize > 0) {
+        const int city = queue[queueHead];
+        queueHead = (queueHead + 1) % V;
+        queueSize--;
+
+        // Ustawienie bitu "don't look" - miasto wróci do kolejki tylko po zmianie sąsiedztwa
+        dontLook[city] = 1;
+        if (improveCity(matrix, candidates, tour, city, cost)) {
+            activate(city);
+        }
+    }
+
+    return cost;
+}
+
+// Próba przeniesienia segmentów zaczynających się lub kończących w mieście city
+// w miejsce wskazane przez listy kandydatów (najpierw krótkie segmenty Or-opt, potem 3-opt)
+template<typename Distances, typename Gene>
+bool LocalSearch::improveCity(const Distances& matrix, const CandidateLists& candidates, Gene* tour, int city,
+                              int& cost) {
+
+    for (int length = 1; length <= maxSegmentLength; length++) {
+
+        // Segment rozpoczynający się w mieście city - wstawienie za bliskim poprzednikiem city
+        int start = position[city];
+        if (start + length <= V) {
+            const int last = tour[start + length - 1];
+            const int* predecessors = candidates.nearestPredecessors(city);
+            for (int i = 0; i < candidates.size(); i++) {
+                if (tryInsertion(matrix, tour, start, length, predecessors[i], cost)) {
+                    return true;
+                }
+            }
+
+            // Wstawienie przed bliskim następnikiem ostatniego miasta segmentu
+            const int* successors = candidates.nearestSuccessors(last);
+            for (int i = 0; i < candidates.size(); i++) {
+                const int predecessor = tour[(position[successors[i]] + V - 1) % V];
+                if (tryInsertion(matrix, tour, start, length, predecessor, cost)) {
+                    return true;
+                }
+            }
+        }
+
+        // Segment kończący się w mieście city - wstawienie przed bliskim następnikiem city
+        start = position[city] - length + 1;
+        if (length > 1 && start >= 0) {
+            const int* successors = candidates.nearestSuccessors(city);
+            for (int i = 0; i < candidates.size(); i++) {
+                const int predecessor = tour[(position[successors[i]] + V - 1) % V];
+                if (tryInsertion(matrix, tour, start, length, predecessor, cost)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return trySegmentInsertion(matrix, candidates, tour, city, cost);
+}
+
+// Ruch 3-opt bez odwracania: segment od miasta city do miasta last (dowolnej długości) wstawiany jest
+// pomiędzy bliskiego poprzednika city (predecessor) i jego następnika next. Miasto last wybierane jest
+// spośród bliskich poprzedników next, więc oba nowe łuki segmentu pochodzą z list kandydatów (k^2 prób)
+template<typename Distances, typename Gene>
+bool LocalSearch::trySegmentInsertion(const Distances& matrix, const CandidateLists& candidates, Gene* tour,
+                                      int city, int& cost) {
+
+    const int start = position[city];
+    const int* predecessors = candidates.nearestPredecessors(city);
+    for (int i = 0; i < candidates.size(); i++) {
+        const int predecessor = predecessors[i];
+        const int predecessorOffset = (position[predecessor] - start + V) % V;
+
+        // Wstawienie za bezpośrednim poprzednikiem city nie zmienia trasy
+        if (predecessorOffset == V - 1) {
+            continue;
+        }
+
+        const int next = tour[(position[predecessor] + 1) % V];
+        const int* lasts = candidates.nearestPredecessors(next);
+        for (int j = 0; j < candidates.size(); j++) {
+            const int last = lasts[j];
+            const int length = (position[last] - start + V) % V + 1;
+
+            // Miasto predecessor nie może należeć do segmentu
+            if (predecessorOffset < length) {
+                continue;
+            }
+
+            if (start + length <= V) {
+                if (tryInsertion(matrix, tour, start, length, predecessor, cost)) {
+                    return true;
+                }
+            } else {
+                // Segment przechodzi przez koniec tablicy trasy - ten sam ruch to przeniesienie fragmentu
+                // od następnika last do predecessor przed miasto city (fragment ten nie przechodzi przez koniec)
+                const int middleStart = position[last] + 1;
+                const int middleLength = position[predecessor] - middleStart + 1;
+                if (tryInsertion(matrix, tour, middleStart, middleLength, tour[(start + V - 1) % V], cost)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+// Przeniesienie segmentu [start, start + length) za miasto predecessor, jeśli zmniejsza koszt
+template<typename Distances, typename Gene>
+bool LocalSearch::tryInsertion(const Distances& matrix, Gene* tour, int start, int length, int predecessor,
+                               int& cost) {
+
+    const int predecessorPosition = position[predecessor];
+
+    // Miasto docelowe nie może należeć do segmentu ani bezpośrednio go poprzedzać
+    if (predecessorPosition >= start && predecessorPosition < start + length) {
+        return false;
+    }
+    if (predecessorPosition == (start + V - 1) % V) {
+        return false;
+    }
+
+    // Pozycja wstawienia w trasie bez segmentu
+    const int reducedPosition = predecessorPosition < start ? predecessorPosition : predecessorPosition - length;
+    const SegmentMove move{start, length, reducedPosition + 1};
+
+    const int change = move.delta(matrix, tour);
+    if (change >= 0) {
+        return false;
+    }
+
+    // Miasta na granicach ruchu (stare i nowe sąsiedztwa) stają się ponownie aktywne
+    activate(tour[(start + V - 1) % V]);
+    activate(tour[(start + length) % V]);
+    activate(predecessor);
+    activate(tour[(predecessorPosition + 1) % V]);
+    activate(tour[start + length - 1]);
+
+    move.apply(tour);
+    cost += change;
+
+    // Aktualizacja pozycji miast w przesuniętym fragmencie
+    const int from = min(start, move.target);
+    const int to = max(start + length, move.target + length);
+    for (int i = from; i < to; i++) {
+        position[tour[i]] = i;
+    }
+
+    return true;
+}
+
+// Wyzerowanie bitu "don't look" miasta i dopisanie go na koniec kolejki aktywnych miast
+void LocalSearch::activate(int city) {
+    if (dontLook[city]) {
+        dontLook[city] = 0;
+        queue[(queueHead + queueSize) % V] = city;
+        queueSize++;
+    }
+}
+
+// Konkretyzacje dla widoków macierzy o elementach 16- i 32-bitowych, współrzędnych i łuków rzadkich
+// oraz genów uint16_t i int
+template int LocalSearch::improve(const DistanceView<int16_t>&, const CandidateLists&, uint16_t*, int);
+
+template int LocalSearch::improve(const DistanceView<int16_t>&, const CandidateLists&, int*, int);
+
+template int LocalSearch::improve(const DistanceView<int32_t>&, const CandidateLists&, uint16_t*, int);
+
+template int LocalSearch::improve(const DistanceView<int32_t>&, const CandidateLists&, int*, int);
+
+template int LocalSearch::improve(const CoordinateDistances&, const CandidateLists&, uint16_t*, int);
+
+template int LocalSearch::improve(const CoordinateDistances&, const CandidateLists&, int*, int);
+
+template int LocalSearch::improve(const SparseDistances&, const CandidateLists&, uint16_t*, int);
+
+template int LocalSearch::improve(const SparseDistances&, const CandidateLists&, int*, int);
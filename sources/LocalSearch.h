@@ -0,0 +1,79 @@
+#ifndef GENETIC_ALGORITHM_LOCALSEARCH_H
+#define GENETIC_ALGORITHM_LOCALSEARCH_H
+
+
+#include <vector>
+
+#include "DistanceProvider.h"
+
+using namespace std;
+
+// Listy kandydatów - dla każdego miasta k najbliższych poprzedników (najtańsze łuki wchodzące)
+// i k najbliższych następników (najtańsze łuki wychodzące). Budowane raz dla instancji.
+class CandidateLists {
+public:
+    void build(const DistanceProvider& distances, int newSize);
+
+    int size() const {
+        return k;
+    }
+
+    const int* nearestPredecessors(int city) const {
+        return predecessors.data() + static_cast<size_t>(city) * k;
+    }
+
+    const int* nearestSuccessors(int city) const {
+        return successors.data() + static_cast<size_t>(city) * k;
+    }
+
+private:
+    int k = 0;
+    vector<int> predecessors;
+    vector<int> successors;
+
+    void buildSparse(const SparseDistances& sparse);
+};
+
+// Przeszukiwanie lokalne dla ATSP oparte na dwóch ruchach bez odwracania kierunku fragmentów trasy
+// (bezpiecznych dla macierzy asymetrycznej): Or-opt - przeniesienie segmentu 1..maxSegmentLength
+// miast w inne miejsce trasy, oraz 3-opt przez wstawienie segmentu dowolnej długości. Miejsca
+// wstawienia (i końce segmentów 3-opt) ograniczone są do list kandydatów, a bity "don't look"
+// pomijają miasta, w otoczeniu których ostatnio nie znaleziono poprawy.
+// Obiekt przechowuje bufory robocze, więc każdy wątek powinien mieć własną instancję.
+class LocalSearch {
+public:
+    void prepare(int V, int newMaxSegmentLength = 3);
+
+    // Poprawa trasy tour o koszcie cost do osiągnięcia optimum lokalnego - zwraca nowy koszt.
+    // Szablon widoku macierzy i typu genu - konkretyzacje w LocalSearch.cpp
+    template<typename Distances, typename Gene>
+    int improve(const Distances& matrix, const CandidateLists& candidates, Gene* tour, int cost);
+
+private:
+    int V = 0;
+    int maxSegmentLength = 3;
+
+    // Pozycje miast w trasie
+    vector<int> position;
+
+    // Bity "don't look" oraz cykliczna kolejka aktywnych miast (każde miasto co najwyżej raz)
+    vector<unsigned char> dontLook;
+    vector<int> queue;
+    int queueHead = 0;
+    int queueSize = 0;
+
+    template<typename Distances, typename Gene>
+    bool improveCity(const Distances& matrix, const CandidateLists& candidates, Gene* tour, int city, int& cost);
+
+    template<typename Distances, typename Gene>
+    bool trySegmentInsertion(const Distances& matrix, const CandidateLists& candidates, Gene* tour, int city,
+                             int& cost);
+
+    template<typename Distances, typename Gene>
+    bool tryInsertion(const Distances& matrix, Gene* tour, int start, int length, int predecessor, int& cost);
+
+    void activate(int city);
+};
+
+
+#endif //GENETIC_ALGORITHM_LOCALSEARCH_H
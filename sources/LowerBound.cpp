@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "LowerBound.h"
+
+namespace {
+
+    // Minimalna arborescencja (skierowane drzewo rozpinające) w grafie pełnym - algorytm Chu-Liu/Edmondsa
+    // w wersji Gabowa i Tarjana: łuki wchodzące do każdego wierzchołka w kopcach skośnych z leniwym
+    // przesunięciem wag, ściągane cykle w zbiorach rozłącznych z wycofywaniem (do odtworzenia drzewa).
+    // Łuk o numerze e odpowiada parze (e / V, e % V); łuki pętli i łuki wchodzące do korzenia są pomijane.
+    class MinimumArborescence {
+    public:
+        explicit MinimumArborescence(int newDimension) : V(newDimension) {
+            const size_t arcCount = static_cast<size_t>(V) * V;
+            weight.resize(arcCount);
+            left.resize(arcCount);
+            right.resize(arcCount);
+            shift.resize(arcCount);
+            heap.resize(V);
+            seen.resize(V);
+            path.resize(V);
+            queue.resize(V);
+            incoming.resize(V);
+            unionParent.resize(V);
+        }
+
+        // Koszt minimalnej arborescencji o korzeniu root dla wag arcWeight(from, to); parent - poprzednik
+        // każdego wierzchołka w drzewie (-1 dla korzenia)
+        template<typename ArcWeight>
+        double solve(int root, ArcWeight&& arcWeight, vector<int>& parent) {
+            fill(heap.begin(), heap.end(), -1);
+            for (int from = 0; from < V; from++) {
+                for (int to = 0; to < V; to++) {
+                    if (from == to || to == root) {
+                        continue;
+                    }
+                    const int arc = from * V + to;
+                    weight[arc] = arcWeight(from, to);
+                    left[arc] = right[arc] = -1;
+                    shift[arc] = 0.0;
+                    heap[to] = merge(heap[to], arc);
+                }
+            }
+
+            fill(unionParent.begin(), unionParent.end(), -1);
+            history.clear();
+            cycles.clear();
+            cycleArcs.clear();
+            fill(seen.begin(), seen.end(), -1);
+            fill(incoming.begin(), incoming.end(), -1);
+            seen[root] = root;
+
+            double total = 0.0;
+            for (int start = 0; start < V; start++) {
+                int vertex = start;
+                int length = 0;
+                while (seen[vertex] < 0) {
+                    // Najtańszy łuk wchodzący do (ściągniętego) wierzchołka
+                    const int arc = top(heap[vertex]);
+                    const double arcCost = weight[arc];
+                    shift[heap[vertex]] -= arcCost;
+                    heap[vertex] = pop(heap[vertex]);
+
+                    queue[length] = arc;
+                    path[length++] = vertex;
+                    seen[vertex] = start;
+                    total += arcCost;
+                    vertex = find(arc / V);
+
+                    // Cykl - ściągnięcie jego wierzchołków w jeden (połączenie kopców łuków wchodzących)
+                    if (seen[vertex] == start) {
+                        int cycleHeap = -1;
+                        const int end = length;
+                        const size_t time = history.size();
+                        int member;
+                        do {
+                            member = path[--length];
+                            cycleHeap = merge(cycleHeap, heap[member]);
+                        } while (join(vertex, member));
+                        vertex = find(vertex);
+                        heap[vertex] = cycleHeap;
+                        seen[vertex] = -1;
+                        cycles.push_back(Cycle{vertex, time, cycleArcs.size(), 0});
+                        cycleArcs.insert(cycleArcs.end(), queue.begin() + length, queue.begin() + end);
+                        cycles.back().arcsEnd = cycleArcs.size();
+                    }
+                }
+                for (int i = 0; i < length; i++) {
+                    incoming[find(queue[i] % V)] = queue[i];
+                }
+            }
+
+            // Rozwinięcie cykli od ostatnio ściągniętego - łuk wchodzący do cyklu zastępuje łuk cyklu
+            for (auto cycle = cycles.rbegin(); cycle != cycles.rend(); ++cycle) {
+                rollback(cycle->time);
+                const int enteringArc = incoming[cycle->vertex];
+                for (size_t i = cycle->arcsBegin; i < cycle->arcsEnd; i++) {
+                    incoming[find(cycleArcs[i] % V)] = cycleArcs[i];
+                }
+                incoming[find(enteringArc % V)] = enteringArc;
+            }
+
+            parent.assign(V, -1);
+            for (int vertex = 0; vertex < V; vertex++) {
+                if (vertex != root) {
+                    parent[vertex] = incoming[vertex] / V;
+                }
+            }
+            return total;
+        }
+
+    private:
+        struct Cycle {
+            int vertex;
+            size_t time;
+            size_t arcsBegin;
+            size_t arcsEnd;
+        };
+
+        int V;
+
+        // Kopce skośne łuków (węzeł kopca = łuk) z przesunięciem wag przekazywanym leniwie do potomków
+        vector<double> weight;
+        vector<int> left;
+        vector<int> right;
+        vector<double> shift;
+        vector<int> heap;
+        vector<int> spine;
+
+        vector<int> seen;
+        vector<int> path;
+        vector<int> queue;
+        vector<int> incoming;
+
+        // Zbiory rozłączne bez kompresji ścieżek (ujemny rozmiar w korzeniu) z historią zmian
+        vector<int> unionParent;
+        vector<pair<int, int>> history;
+
+        vector<Cycle> cycles;
+        vector<int> cycleArcs;
+
+        void propagate(int node) {
+            if (shift[node] != 0.0) {
+                weight[node] += shift[node];
+                if (left[node] >= 0) {
+                    shift[left[node]] += shift[node];
+                }
+                if (right[node] >= 0) {
+                    shift[right[node]] += shift[node];
+                }
+                shift[node] = 0.0;
+            }
+        }
+
+        int top(int node) {
+            propagate(node);
+            return node;
+        }
+
+        // Scalenie kopców skośnych (iteracyjnie wzdłuż prawych ścieżek, bez rekurencji)
+        int merge(int a, int b) {
+            if (a < 0) {
+                return b;
+            }
+            if (b < 0) {
+                return a;
+            }
+            spine.clear();
+            while (a >= 0 && b >= 0) {
+                propagate(a);
+                propagate(b);
+                if (weight[a] > weight[b]) {
+                    swap(a, b);
+                }
+                spine.push_back(a);
+                a = right[a];
+            }
+            int rest = a >= 0 ? a : b;
+            for (auto node = spine.rbegin(); node != spine.rend(); ++node) {
+                right[*node] = rest;
+                swap(left[*node], right[*node]);
+                rest = *node;
+            }
+            return rest;
+        }
+
+        int pop(int node) {
+            propagate(node);
+            return merge(left[node], right[node]);
+        }
+
+        int find(int vertex) const {
+            while (unionParent[vertex] >= 0) {
+                vertex = unionParent[vertex];
+            }
+            return vertex;
+        }
+
+        bool join(int a, int b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return false;
+            }
+            if (unionParent[a] > unionParent[b]) {
+                swap(a, b);
+            }
+            history.emplace_back(a, unionParent[a]);
+            history.emplace_back(b, unionParent[b]);
+            unionParent[a] += unionParent[b];
+            unionParent[b] = a;
+            return true;
+        }
+
+        void rollback(size_t time) {
+            while (history.size() > time) {
+                unionParent[history.back().first] = history.back().second;
+                history.pop_back();
+            }
+        }
+    };
+
+    // Koszt trasy najbliższego sąsiada od miasta 0 - górne ograniczenie dla długości kroku subgradientowego
+    template<typename Distances>
+    long long nearestNeighbourCost(const Distances& distances) {
+        const int V = distances.dimension();
+        vector<unsigned char> visited(V, 0);
+        int current = 0;
+        visited[0] = 1;
+        long long cost = 0;
+        for (int step = 1; step < V; step++) {
+            int next = -1;
+            for (int city = 0; city < V; city++) {
+                if (!visited[city] && (next < 0 || distances(current, city) < distances(current, next))) {
+                    next = city;
+                }
+            }
+            cost += distances(current, next);
+            visited[next] = 1;
+            current = next;
+        }
+        return cost + distances(current, 0);
+    }
+}
+
+LowerBound::Method LowerBound::methodFromName(const string& methodName) {
+    if (methodName == "AP") {
+        return Method::Assignment;
+    } else if (methodName == "HK") {
+        return Method::Arborescence;
+    }
+    return Method::None;
+}
+
+long long LowerBound::compute(const DistanceProvider& distances, Method method, int iterations) {
+    return distances.visit([&](const auto& view) {
+        const long long assignmentBound = assignment(view);
+        if (method != Method::Arborescence) {
+            return assignmentBound;
+        }
+        return max(assignmentBound, arborescence(view, iterations));
+    });
+}
+
+// Problem przydziału - algorytm węgierski z potencjałami (O(V^3)), macierz indeksowana od 1,
+// a wiersz i kolumna 0 są pomocnicze. Pętle (i, i) mają koszt nieskończony
+template<typename Distances>
+long long LowerBound::assignment(const Distances& distances) {
+    const int V = distances.dimension();
+    const long long infinity = numeric_limits<long long>::max() / 4;
+    auto cost = [&](int row, int column) -> long long {
+        return row == column ? infinity : distances(row - 1, column - 1);
+    };
+
+    vector<long long> rowPotential(V + 1, 0);
+    vector<long long> columnPotential(V + 1, 0);
+    vector<int> assigned(V + 1, 0);
+    vector<int> way(V + 1, 0);
+    vector<long long> minimum(V + 1);
+    vector<unsigned char> used(V + 1);
+
+    for (int row = 1; row <= V; row++) {
+        assigned[0] = row;
+        int column = 0;
+        fill(minimum.begin(), minimum.end(), infinity);
+        fill(used.begin(), used.end(), 0);
+
+        // Ścieżka powiększająca od wiersza row (algorytm Dijkstry na kosztach zredukowanych)
+        do {
+            used[column] = 1;
+            const int currentRow = assigned[column];
+            long long delta = infinity;
+            int nextColumn = 0;
+            for (int j = 1; j <= V; j++) {
+                if (!used[j]) {
+                    const long long reduced = cost(currentRow, j) - rowPotential[currentRow] - columnPotential[j];
+                    if (reduced < minimum[j]) {
+                        minimum[j] = reduced;
+                        way[j] = column;
+                    }
+                    if (minimum[j] < delta) {
+                        delta = minimum[j];
+                        nextColumn = j;
+                    }
+                }
+            }
+            for (int j = 0; j <= V; j++) {
+                if (used[j]) {
+                    rowPotential[assigned[j]] += delta;
+                    columnPotential[j] -= delta;
+                } else {
+                    minimum[j] -= delta;
+                }
+            }
+            column = nextColumn;
+        } while (assigned[column] != 0);
+
+        // Zamiana przydziałów wzdłuż ścieżki
+        do {
+            const int previousColumn = way[column];
+            assigned[column] = assigned[previousColumn];
+            column = previousColumn;
+        } while (column != 0);
+    }
+
+    long long total = 0;
+    for (int column = 1; column <= V; column++) {
+        total += cost(assigned[column], column);
+    }
+    return total;
+}
+
+// Ograniczenie 1-arborescencji z relaksacją Lagrange'a. Każda trasa jest 1-arborescencją o stopniach
+// wyjściowych równych 1, więc dla kar penalty koszt trasy po zmianie wag c(i, j) + penalty[i] jest
+// większy o sumę kar, a L(penalty) = koszt 1-arborescencji - suma kar jest dolnym ograniczeniem.
+// Kary poprawiane są krokiem Polyaka w kierunku subgradientu (stopień wyjściowy - 1)
+template<typename Distances>
+long long LowerBound::arborescence(const Distances& distances, int iterations) {
+    const int V = distances.dimension();
+    if (V < 3) {
+        return assignment(distances);
+    }
+
+    MinimumArborescence solver(V);
+    vector<double> penalty(V, 0.0);
+    vector<int> parent;
+    vector<int> outDegree(V);
+
+    const double upperBound = static_cast<double>(nearestNeighbourCost(distances));
+    double best = -numeric_limits<double>::infinity();
+    double stepScale = 2.0;
+    int stalled = 0;
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        auto weight = [&](int from, int to) {
+            return distances(from, to) + penalty[from];
+        };
+        double value = solver.solve(0, weight, parent);
+
+        // Najtańszy łuk wchodzący do korzenia zamyka 1-arborescencję
+        int rootPredecessor = 1;
+        for (int from = 2; from < V; from++) {
+            if (weight(from, 0) < weight(rootPredecessor, 0)) {
+                rootPredecessor = from;
+            }
+        }
+        value += weight(rootPredecessor, 0);
+        for (double p : penalty) {
+            value -= p;
+        }
+
+        fill(outDegree.begin(), outDegree.end(), 0);
+        for (int vertex = 1; vertex < V; vertex++) {
+            outDegree[parent[vertex]]++;
+        }
+        outDegree[rootPredecessor]++;
+
+        if (value > best + 1e-9) {
+            best = value;
+            stalled = 0;
+        } else if (++stalled >= 5) {
+            stepScale /= 2.0;
+            stalled = 0;
+        }
+
+        // Stopnie wyjściowe równe 1 - 1-arborescencja jest trasą optymalną dla bieżących kar
+        double norm = 0.0;
+        for (int degree : outDegree) {
+            norm += static_cast<double>(degree - 1) * (degree - 1);
+        }
+        if (norm == 0.0 || stepScale < 1e-4 || upperBound - best < 1.0) {
+            break;
+        }
+
+        const double step = stepScale * max(upperBound - value, 1.0) / norm;
+        for (int vertex = 0; vertex < V; vertex++) {
+            penalty[vertex] += step * (outDegree[vertex] - 1);
+        }
+    }
+
+    // Koszty tras są całkowite - zaokrąglenie w górę z tolerancją błędów zmiennoprzecinkowych
+    return static_cast<long long>(ceil(best - 1e-6));
+}
+
+template long long LowerBound::assignment(const DistanceView<int16_t>&);
+
+template long long LowerBound::assignment(const DistanceView<int32_t>&);
+
+template long long LowerBound::assignment(const CoordinateDistances&);
+
+template long long LowerBound::assignment(const SparseDistances&);
+
+template long long LowerBound::arborescence(const DistanceView<int16_t>&, int);
+
+template long long LowerBound::arborescence(const DistanceView<int32_t>&, int);
+
+template long long LowerBound::arborescence(const CoordinateDistances&, int);
+
+template long long LowerBound::arborescence(const SparseDistances&, int);
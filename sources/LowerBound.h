@@ -0,0 +1,44 @@
+#ifndef GENETIC_ALGORITHM_LOWERBOUND_H
+#define GENETIC_ALGORITHM_LOWERBOUND_H
+
+
+#include <string>
+
+#include "DistanceProvider.h"
+
+using namespace std;
+
+// Dolne ograniczenie kosztu trasy ATSP - pozwala zakończyć obliczenia, gdy najlepsza trasa jest
+// dostatecznie blisko optimum (albo jest optymalna). Dostępne ograniczenia:
+//  AP - problem przydziału (każde miasto ma dokładnie jeden następnik i jeden poprzednik, podcykle
+//       są dozwolone) rozwiązany algorytmem węgierskim w czasie O(V^3)
+//  HK - maksimum z AP i ograniczenia 1-arborescencji z relaksacją Lagrange'a (w stylu Helda-Karpa):
+//       minimalna arborescencja o korzeniu 0 wraz z najtańszym łukiem wchodzącym do 0, z karami
+//       za stopień wyjściowy różny od 1 poprawianymi metodą subgradientową
+// Ograniczenia odczytują odległości przez widok (operator()), więc działają dla każdej postaci danych,
+// ale wymagają O(V^2) odczytów na iterację - liczone są tylko dla instancji do MaxDimension miast.
+class LowerBound {
+public:
+    enum class Method {
+        None,
+        Assignment,
+        Arborescence
+    };
+
+    static constexpr int MaxDimension = 2000;
+
+    // Metoda na podstawie nazwy: OFF, AP, HK (nieznana nazwa - OFF)
+    static Method methodFromName(const string& methodName);
+
+    // Ograniczenie wybraną metodą (iterations - liczba iteracji subgradientowych metody HK)
+    static long long compute(const DistanceProvider& distances, Method method, int iterations);
+
+    template<typename Distances>
+    static long long assignment(const Distances& distances);
+
+    template<typename Distances>
+    static long long arborescence(const Distances& distances, int iterations);
+};
+
+
+#endif //GENETIC_ALGORITHM_LOWERBOUND_H
@@ -0,0 +1,121 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const string& fileName, bool copyOnWrite, Access access) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | (access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                                                                    : FILE_FLAG_RANDOM_ACCESS),
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    opened = true;
+
+    // Pusty plik nie może zostać odwzorowany - traktowany jest jako pusty bufor
+    if (length == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+
+    begin = static_cast<const char*>(MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+    if (begin == nullptr) {
+        close();
+        return false;
+    }
+#else
+    int descriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0) {
+        ::close(descriptor);
+        return false;
+    }
+
+    length = static_cast<size_t>(status.st_size);
+    opened = true;
+
+    if (length == 0) {
+        ::close(descriptor);
+        return true;
+    }
+
+    void* address = mmap(nullptr, length, copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (address == MAP_FAILED) {
+        length = 0;
+        opened = false;
+        return false;
+    }
+
+    // Plik parsowany sekwencyjnie - agresywne wczytywanie z wyprzedzeniem. Przy odczycie w dowolnej
+    // kolejności wyprzedzanie jest wyłączane, a cały plik wczytywany od razu (bez błędów stron
+    // rozproszonych po pierwszych pokoleniach)
+    if (access == Access::Sequential) {
+        madvise(address, length, MADV_SEQUENTIAL);
+    } else {
+        madvise(address, length, MADV_RANDOM);
+        madvise(address, length, MADV_WILLNEED);
+    }
+    begin = static_cast<const char*>(address);
+#endif
+
+    writable = copyOnWrite;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (begin != nullptr) {
+        UnmapViewOfFile(begin);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (begin != nullptr) {
+        munmap(const_cast<char*>(begin), length);
+    }
+#endif
+    begin = nullptr;
+    length = 0;
+    opened = false;
+    writable = false;
+}
@@ -0,0 +1,66 @@
+#ifndef GENETIC_ALGORITHM_MAPPEDFILE_H
+#define GENETIC_ALGORITHM_MAPPEDFILE_H
+
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+// Plik odwzorowany w pamięci (tylko do odczytu) - mmap w systemach POSIX,
+// CreateFileMapping/MapViewOfFile w systemie Windows. Zawartość pliku jest dostępna
+// bez kopiowania do bufora programu. Odwzorowanie copy-on-write pozwala modyfikować
+// strony w pamięci procesu bez zapisywania zmian do pliku.
+class MappedFile {
+public:
+    // Wskazówka dla systemu o sposobie odczytu: Sequential - jednokrotny przegląd (parsowanie pliku,
+    // agresywne wczytywanie z wyprzedzeniem), Random - dane odczytywane w dowolnej kolejności przez
+    // cały czas obliczeń (binarna kopia macierzy, wczytywana z góry w całości)
+    enum class Access {
+        Sequential,
+        Random
+    };
+
+    MappedFile() = default;
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& fileName, bool copyOnWrite = false, Access access = Access::Sequential);
+
+    void close();
+
+    const char* data() const {
+        return begin;
+    }
+
+    // Zapisywalny widok zawartości (tylko dla odwzorowania copy-on-write)
+    char* mutableData() const {
+        return writable ? const_cast<char*>(begin) : nullptr;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    bool isOpen() const {
+        return opened;
+    }
+
+private:
+    const char* begin = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    bool writable = false;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+
+#endif //GENETIC_ALGORITHM_MAPPEDFILE_H
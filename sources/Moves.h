@@ -0,0 +1,158 @@
+#ifndef GENETIC_ALGORITHM_MOVES_H
+#define GENETIC_ALGORITHM_MOVES_H
+
+
+#include <algorithm>
+#include <utility>
+
+#include "DistanceMatrix.h"
+#include "TourHash.h"
+
+using namespace std;
+
+// Ruchy modyfikujące trasę wraz z obliczaniem zmiany kosztu w czasie O(1).
+// Macierz jest asymetryczna, więc żaden ruch nie odwraca kierunku fragmentu trasy -
+// zmieniają się tylko łuki na granicach przenoszonych elementów.
+// Metody są szablonami typu odległości (widok macierzy, np. DistanceView<int16_t>) i typu genu.
+
+// Przeniesienie segmentu [start, start + length) tak, aby po przeniesieniu zaczynał się
+// na pozycji target. Pozycja target liczona jest w trasie bez segmentu (0 .. V - length),
+// więc dla length = 1 jest to ruch wstawienia (usunięcie genu i wstawienie go na pozycję target).
+struct SegmentMove {
+    int start = 0;
+    int length = 1;
+    int target = 0;
+
+    // Ruch wstawienia pojedynczego genu z pozycji from na pozycję to
+    static SegmentMove insertion(int from, int to) {
+        return SegmentMove{from, 1, to};
+    }
+
+    // Zmiana kosztu trasy po wykonaniu ruchu (bez modyfikacji trasy)
+    template<typename Distances, typename Gene>
+    int delta(const Distances& matrix, const Gene* tour) const {
+        const int V = matrix.dimension();
+        const int reducedSize = V - length;
+
+        // Geny trasy bez segmentu (indeksowane cyklicznie)
+        auto reduced = [&](int k) -> int {
+            k = (k % reducedSize + reducedSize) % reducedSize;
+            return k < start ? tour[k] : tour[k + length];
+        };
+
+        const int first = tour[start];
+        const int last = tour[start + length - 1];
+
+        // Sąsiedzi segmentu przed ruchem oraz po ruchu
+        const int before = tour[(start + V - 1) % V];
+        const int after = tour[(start + length) % V];
+        const int newBefore = reduced(target - 1);
+        const int newAfter = reduced(target);
+
+        // Usunięcie segmentu: łuki (before, first) i (last, after) zastępuje łuk (before, after).
+        // Wstawienie segmentu: łuk (newBefore, newAfter) zastępują (newBefore, first) i (last, newAfter).
+        return matrix(before, after) - matrix(before, first) - matrix(last, after)
+               + matrix(newBefore, first) + matrix(last, newAfter) - matrix(newBefore, newAfter);
+    }
+
+    // Zmiana skrótu trasy (TourHash) po wykonaniu ruchu - XOR kluczy usuniętych i dodanych łuków
+    template<typename Gene>
+    uint64_t hashDelta(const TourHash& hashes, const Gene* tour, int V) const {
+        const int reducedSize = V - length;
+
+        auto reduced = [&](int k) -> int {
+            k = (k % reducedSize + reducedSize) % reducedSize;
+            return k < start ? tour[k] : tour[k + length];
+        };
+
+        const int first = tour[start];
+        const int last = tour[start + length - 1];
+        const int before = tour[(start + V - 1) % V];
+        const int after = tour[(start + length) % V];
+        const int newBefore = reduced(target - 1);
+        const int newAfter = reduced(target);
+
+        return hashes.arc(before, after) ^ hashes.arc(before, first) ^ hashes.arc(last, after)
+               ^ hashes.arc(newBefore, first) ^ hashes.arc(last, newAfter) ^ hashes.arc(newBefore, newAfter);
+    }
+
+    // Wykonanie ruchu - jedna operacja rotate na fragmencie pomiędzy segmentem a pozycją docelową
+    template<typename Gene>
+    void apply(Gene* tour) const {
+        if (target <= start) {
+            // Segment przesuwany w lewo
+            rotate(tour + target, tour + start, tour + start + length);
+        } else {
+            // Segment przesuwany w prawo - za gen, który w trasie bez segmentu ma indeks target - 1
+            rotate(tour + start, tour + start + length, tour + target + length);
+        }
+    }
+};
+
+// Zamiana miejscami genów z pozycji first i second
+struct SwapMove {
+    int first = 0;
+    int second = 0;
+
+    // Zmiana kosztu trasy po wykonaniu ruchu (bez modyfikacji trasy)
+    template<typename Distances, typename Gene>
+    int delta(const Distances& matrix, const Gene* tour) const {
+        const int V = matrix.dimension();
+
+        int positions[4];
+        const int count = changedArcs(V, positions);
+
+        int change = 0;
+        for (int i = 0; i < count; i++) {
+            const int from = positions[i];
+            const int to = (from + 1) % V;
+            change += matrix(swapped(tour, from), swapped(tour, to)) - matrix(tour[from], tour[to]);
+        }
+
+        return change;
+    }
+
+    // Zmiana skrótu trasy (TourHash) po wykonaniu ruchu - XOR kluczy usuniętych i dodanych łuków
+    template<typename Gene>
+    uint64_t hashDelta(const TourHash& hashes, const Gene* tour, int V) const {
+        int positions[4];
+        const int count = changedArcs(V, positions);
+
+        uint64_t change = 0;
+        for (int i = 0; i < count; i++) {
+            const int from = positions[i];
+            const int to = (from + 1) % V;
+            change ^= hashes.arc(tour[from], tour[to]) ^ hashes.arc(swapped(tour, from), swapped(tour, to));
+        }
+
+        return change;
+    }
+
+    template<typename Gene>
+    void apply(Gene* tour) const {
+        swap(tour[first], tour[second]);
+    }
+
+private:
+    // Gen na pozycji k po zamianie
+    template<typename Gene>
+    int swapped(const Gene* tour, int k) const {
+        return k == first ? tour[second] : (k == second ? tour[first] : tour[k]);
+    }
+
+    // Pozycje początków łuków zmienianych przez ruch: first - 1, first, second - 1, second
+    // (bez powtórzeń, gdy geny sąsiadują ze sobą). Zwraca liczbę pozycji
+    int changedArcs(int V, int* positions) const {
+        const int candidates[4] = {(first + V - 1) % V, first, (second + V - 1) % V, second};
+        int count = 0;
+        for (int position : candidates) {
+            if (find(positions, positions + count, position) == positions + count) {
+                positions[count++] = position;
+            }
+        }
+        return count;
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_MOVES_H
@@ -0,0 +1,53 @@
+#ifndef GENETIC_ALGORITHM_NUMBERPARSING_H
+#define GENETIC_ALGORITHM_NUMBERPARSING_H
+
+
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// Ścisła konwersja wartości parametrów - w przeciwieństwie do samych stoi/stod cały tekst musi być
+// liczbą, więc np. "10x" jest błędem, a nie wartością 10. Błąd zgłaszany jest tak jak w stoi
+// (wyjątek invalid_argument lub out_of_range), więc wywołujący obsługują oba przypadki razem.
+
+inline void requireWholeNumber(const string& text, size_t consumed) {
+    if (consumed != text.size()) {
+        throw invalid_argument("invalid number " + text);
+    }
+}
+
+inline int parseInt(const string& text) {
+    size_t consumed = 0;
+    const int value = stoi(text, &consumed);
+    requireWholeNumber(text, consumed);
+    return value;
+}
+
+inline long long parseLongLong(const string& text) {
+    size_t consumed = 0;
+    const long long value = stoll(text, &consumed);
+    requireWholeNumber(text, consumed);
+    return value;
+}
+
+// stoull zamienia liczbę ujemną na dużą liczbę dodatnią - znak minus jest odrzucany
+inline unsigned long long parseUnsigned(const string& text) {
+    if (text.find('-') != string::npos) {
+        throw invalid_argument("invalid number " + text);
+    }
+    size_t consumed = 0;
+    const unsigned long long value = stoull(text, &consumed);
+    requireWholeNumber(text, consumed);
+    return value;
+}
+
+inline double parseDouble(const string& text) {
+    size_t consumed = 0;
+    const double value = stod(text, &consumed);
+    requireWholeNumber(text, consumed);
+    return value;
+}
+
+
+#endif //GENETIC_ALGORITHM_NUMBERPARSING_H
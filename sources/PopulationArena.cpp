@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <type_traits>
+
+#include "PopulationArena.h"
+
+// Jednorazowa alokacja wszystkich slotów areny
+void PopulationArena::allocate(int newPopulationSize, int newDimension, int newGeneWidth) {
+    N = newPopulationSize;
+    V = newDimension;
+    width = newGeneWidth;
+
+    const size_t slotCount = static_cast<size_t>(2) * N;
+    chromosomes.assign(slotCount * V * width, 0);
+    costs.assign(slotCount, 0);
+    dirtyFlags.assign(slotCount, 1);
+    hashes.assign(slotCount, 0);
+    hashFlags.assign(slotCount, 0);
+
+    population.resize(N);
+    offspring.resize(N);
+    for (int i = 0; i < N; i++) {
+        population[i] = i;
+        offspring[i] = N + i;
+    }
+
+    populationCosts.assign(N, 0);
+    used.assign(slotCount, 0);
+    duplicates.reserve(N);
+}
+
+const int* PopulationArena::currentCosts() {
+    for (int i = 0; i < N; i++) {
+        populationCosts[i] = costs[population[i]];
+    }
+    return populationCosts.data();
+}
+
+void PopulationArena::readGenes(int slot, int* destination) const {
+    visitGenes(slot, [&](const auto* source) {
+        copy(source, source + V, destination);
+    });
+}
+
+void PopulationArena::writeGenes(int slot, const int* source) {
+    visitGenes(slot, [&](auto* destination) {
+        using Gene = remove_pointer_t<decltype(destination)>;
+        transform(source, source + V, destination, [](int gene) {
+            return static_cast<Gene>(gene);
+        });
+    });
+    hashFlags[slot] = 0;
+}
+
+void PopulationArena::copySlot(int from, int to) {
+    const size_t slotBytes = static_cast<size_t>(V) * width;
+    copy(chromosomes.data() + from * slotBytes, chromosomes.data() + (from + 1) * slotBytes,
+         chromosomes.data() + to * slotBytes);
+    costs[to] = costs[from];
+    dirtyFlags[to] = dirtyFlags[from];
+    hashes[to] = hashes[from];
+    hashFlags[to] = hashFlags[from];
+}
+
+void PopulationArena::replacePopulation(const vector<int>& survivors) {
+
+    fill(used.begin(), used.end(), 0);
+    duplicates.clear();
+
+    // Zwycięzcy przechodzą do nowego pokolenia bez kopiowania - zmienia się tylko lista slotów
+    for (int i = 0; i < N; i++) {
+        population[i] = survivors[i];
+        if (used[survivors[i]]) {
+            duplicates.push_back(i);
+        } else {
+            used[survivors[i]] = 1;
+        }
+    }
+
+    // Wolne sloty - najpierw na kopie powtórzonych osobników, pozostałe na potomstwo
+    int offspringCount = 0;
+    size_t duplicateIndex = 0;
+    for (int slot = 0; slot < 2 * N; slot++) {
+        if (used[slot]) {
+            continue;
+        }
+        if (duplicateIndex < duplicates.size()) {
+            const int position = duplicates[duplicateIndex++];
+            copySlot(population[position], slot);
+            population[position] = slot;
+        } else {
+            offspring[offspringCount++] = slot;
+        }
+    }
+}
@@ -0,0 +1,169 @@
+#ifndef GENETIC_ALGORITHM_POPULATIONARENA_H
+#define GENETIC_ALGORITHM_POPULATIONARENA_H
+
+
+#include <cstdint>
+#include <vector>
+
+#include "DistanceMatrix.h"
+
+using namespace std;
+
+// Arena populacji - wszystkie chromosomy algorytmu przydzielane są jednorazowo,
+// w jednym ciągłym bloku pamięci (slot = V genów). Arena ma 2 * N slotów tworzących
+// dwa naprzemienne bufory: bieżące pokolenie (N slotów) i potomstwo (N slotów).
+// Przynależność slotów do buforów opisują listy indeksów, więc po sukcesji zwycięzcy
+// są przenoszeni do nowego pokolenia przez zmianę indeksów (bez kopiowania genów),
+// a zwolnione sloty przegranych stają się buforem potomstwa kolejnego pokolenia.
+// Rodzice wskazywani są indeksami, a operatory zapisują potomków bezpośrednio
+// do slotów areny, dzięki czemu pętla główna nie alokuje pamięci.
+// Geny zapisywane są w najwęższym typie mieszczącym numery miast: uint16_t (do 65536 miast)
+// albo int. Szablony pętli algorytmu odczytują je przez genes<Gene>(), a pozostałe miejsca
+// kopiują chromosomy do i z tablic int (readGenes, writeGenes).
+class PopulationArena {
+public:
+    // Szerokość genu w bajtach dla problemu o V miastach
+    static int geneWidthFor(int V) {
+        return V <= 65536 ? sizeof(uint16_t) : sizeof(int);
+    }
+
+    void allocate(int newPopulationSize, int newDimension, int newGeneWidth = sizeof(int));
+
+    int populationSize() const {
+        return N;
+    }
+
+    int dimension() const {
+        return V;
+    }
+
+    int geneWidth() const {
+        return width;
+    }
+
+    // Numery slotów i-tego osobnika bieżącego pokolenia oraz i-tego potomka
+    int currentSlot(int i) const {
+        return population[i];
+    }
+
+    int offspringSlot(int i) const {
+        return offspring[i];
+    }
+
+    // Listy slotów bieżącego pokolenia i potomstwa (kolejność osobników może być zmieniana)
+    vector<int>& populationSlots() {
+        return population;
+    }
+
+    const vector<int>& offspringSlots() const {
+        return offspring;
+    }
+
+    // Geny slotu - typ Gene musi mieć szerokość geneWidth()
+    template<typename Gene>
+    Gene* genes(int slot) {
+        return reinterpret_cast<Gene*>(chromosomes.data()) + static_cast<size_t>(slot) * V;
+    }
+
+    template<typename Gene>
+    const Gene* genes(int slot) const {
+        return reinterpret_cast<const Gene*>(chromosomes.data()) + static_cast<size_t>(slot) * V;
+    }
+
+    // Wywołanie funkcji ze wskaźnikiem na geny slotu w ich rzeczywistym typie
+    template<typename Function>
+    auto visitGenes(int slot, Function&& function) {
+        if (width == sizeof(uint16_t)) {
+            return function(genes<uint16_t>(slot));
+        }
+        return function(genes<int>(slot));
+    }
+
+    template<typename Function>
+    auto visitGenes(int slot, Function&& function) const {
+        if (width == sizeof(uint16_t)) {
+            return function(genes<uint16_t>(slot));
+        }
+        return function(genes<int>(slot));
+    }
+
+    // Kopiowanie chromosomu slotu do tablicy int (V elementów) i z tablicy int
+    void readGenes(int slot, int* destination) const;
+
+    void writeGenes(int slot, const int* source);
+
+    int& cost(int slot) {
+        return costs[slot];
+    }
+
+    int cost(int slot) const {
+        return costs[slot];
+    }
+
+    // Koszty osobników bieżącego pokolenia w kolejności listy populacji (N kolejnych wartości)
+    const int* currentCosts();
+
+    bool isDirty(int slot) const {
+        return dirtyFlags[slot] != 0;
+    }
+
+    // Oznaczenie zmienionego chromosomu unieważnia także jego skrót
+    void setDirty(int slot, bool dirty) {
+        dirtyFlags[slot] = dirty ? 1 : 0;
+        if (dirty) {
+            hashFlags[slot] = 0;
+        }
+    }
+
+    // Skrót trasy slotu (TourHash) - obliczany tylko przy eliminacji duplikatów lub pamięci kosztów
+    bool hasHash(int slot) const {
+        return hashFlags[slot] != 0;
+    }
+
+    uint64_t hash(int slot) const {
+        return hashes[slot];
+    }
+
+    void setHash(int slot, uint64_t hash) {
+        hashes[slot] = hash;
+        hashFlags[slot] = 1;
+    }
+
+    void clearHash(int slot) {
+        hashFlags[slot] = 0;
+    }
+
+    // Skopiowanie chromosomu wraz z kosztem i skrótem między slotami
+    void copySlot(int from, int to);
+
+    // Ustanowienie nowego pokolenia z N slotów (mogą się powtarzać - powtórzenia są kopiowane
+    // do wolnych slotów); pozostałe sloty tworzą bufor potomstwa
+    void replacePopulation(const vector<int>& survivors);
+
+private:
+    int N = 0;
+    int V = 0;
+
+    // Szerokość genu w bajtach
+    int width = sizeof(int);
+
+    // Geny wszystkich slotów (2 * N * V genów)
+    vector<unsigned char, AlignedAllocator<unsigned char, DistanceMatrix::CacheLineSize>> chromosomes;
+
+    vector<int> costs;
+    vector<unsigned char> dirtyFlags;
+    vector<uint64_t> hashes;
+    vector<unsigned char> hashFlags;
+
+    // Sloty bieżącego pokolenia i potomstwa
+    vector<int> population;
+    vector<int> offspring;
+
+    // Bufory pomocnicze (alokowane jednorazowo)
+    vector<int> populationCosts;
+    vector<unsigned char> used;
+    vector<int> duplicates;
+};
+
+
+#endif //GENETIC_ALGORITHM_POPULATIONARENA_H
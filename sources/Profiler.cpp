@@ -0,0 +1,85 @@
+#include <iomanip>
+
+#include "Profiler.h"
+
+void Profiler::prepare(int workerCount) {
+    workers.assign(workerCount, PhaseCounters());
+}
+
+void Profiler::merge(const Profiler& other) {
+    if (workers.empty()) {
+        workers.resize(1);
+    }
+    for (const PhaseCounters& counters : other.workers) {
+        for (size_t phase = 0; phase < counters.nanoseconds.size(); phase++) {
+            workers[0].nanoseconds[phase] += counters.nanoseconds[phase];
+            workers[0].calls[phase] += counters.calls[phase];
+        }
+    }
+}
+
+long long Profiler::nanoseconds(Phase phase) const {
+    long long total = 0;
+    for (const PhaseCounters& counters : workers) {
+        total += counters.nanoseconds[static_cast<size_t>(phase)];
+    }
+    return total;
+}
+
+long long Profiler::calls(Phase phase) const {
+    long long total = 0;
+    for (const PhaseCounters& counters : workers) {
+        total += counters.calls[static_cast<size_t>(phase)];
+    }
+    return total;
+}
+
+const char* Profiler::phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Fitness:
+            return "Obliczanie kosztu";
+        case Phase::Probabilities:
+            return "Prawdopodobienstwa selekcji";
+        case Phase::Selection:
+            return "Selekcja";
+        case Phase::Crossover:
+            return "Krzyzowanie";
+        case Phase::Mutation:
+            return "Mutacja";
+        case Phase::LocalSearch:
+            return "Przeszukiwanie lokalne";
+        case Phase::Succession:
+            return "Sukcesja";
+        case Phase::BestTracking:
+            return "Sledzenie najlepszego";
+        case Phase::Migration:
+            return "Migracja";
+        default:
+            return "";
+    }
+}
+
+void Profiler::report(ostream& output) const {
+    const int phaseCount = static_cast<int>(Phase::Count);
+
+    // Czasy etapów wykonywanych równolegle są sumą czasów wszystkich wątków
+    long long totalNanoseconds = 0;
+    for (int phase = 0; phase < phaseCount; phase++) {
+        totalNanoseconds += nanoseconds(static_cast<Phase>(phase));
+    }
+
+    output << "Profil etapow (suma czasow watkow):" << endl;
+    for (int phase = 0; phase < phaseCount; phase++) {
+        const Phase current = static_cast<Phase>(phase);
+        if (calls(current) == 0) {
+            continue;
+        }
+        const double seconds = nanoseconds(current) / 1e9;
+        output << "  " << left << setw(30) << phaseName(current) << right
+               << fixed << setprecision(4) << setw(10) << seconds << "s"
+               << setprecision(1) << setw(7) << (totalNanoseconds > 0 ? 100.0 * nanoseconds(current) / totalNanoseconds : 0.0) << "%"
+               << "  wywolania: " << calls(current) << endl;
+    }
+    output.unsetf(ios::floatfield);
+    output << setprecision(6);
+}
@@ -0,0 +1,93 @@
+#ifndef GENETIC_ALGORITHM_PROFILER_H
+#define GENETIC_ALGORITHM_PROFILER_H
+
+
+#include <array>
+#include <ostream>
+#include <vector>
+
+#include "Timer.h"
+
+using namespace std;
+
+// Etapy pokolenia algorytmu genetycznego mierzone przez profiler
+enum class Phase {
+    Fitness,
+    Probabilities,
+    Selection,
+    Crossover,
+    Mutation,
+    LocalSearch,
+    Succession,
+    BestTracking,
+    Migration,
+    Count
+};
+
+// Czas i liczba wywołań etapów zliczane osobno dla każdego wątku roboczego
+// (wyrównanie do linii pamięci podręcznej - wątki nie współdzielą linii)
+struct alignas(64) PhaseCounters {
+    array<long long, static_cast<size_t>(Phase::Count)> nanoseconds{};
+    array<long long, static_cast<size_t>(Phase::Count)> calls{};
+};
+
+// Profiler etapów pokolenia. Pomiary włączane są makrem GA_PROFILING (np. -DGA_PROFILING) -
+// bez niego makra GA_PROFILE_* nie generują żadnego kodu, a raport nie jest wyświetlany.
+class Profiler {
+public:
+    void prepare(int workerCount);
+
+    void add(int worker, Phase phase, long long nanoseconds) {
+        PhaseCounters& counters = workers[worker];
+        counters.nanoseconds[static_cast<size_t>(phase)] += nanoseconds;
+        counters.calls[static_cast<size_t>(phase)]++;
+    }
+
+    // Dołączenie pomiarów innego profilera (np. innej wyspy)
+    void merge(const Profiler& other);
+
+    long long nanoseconds(Phase phase) const;
+
+    long long calls(Phase phase) const;
+
+    static const char* phaseName(Phase phase);
+
+    // Raport: czas i udział etapów oraz liczba wywołań
+    void report(ostream& output) const;
+
+private:
+    vector<PhaseCounters> workers;
+};
+
+// Pomiar czasu etapu od utworzenia obiektu do końca zasięgu
+class ScopedPhase {
+public:
+    ScopedPhase(Profiler& profiler, int worker, Phase phase)
+            : profiler(profiler), worker(worker), phase(phase), start(Timer::nanoseconds()) {}
+
+    ~ScopedPhase() {
+        profiler.add(worker, phase, Timer::nanoseconds() - start);
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    Profiler& profiler;
+    int worker;
+    Phase phase;
+    long long start;
+};
+
+#ifdef GA_PROFILING
+#define GA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GA_PROFILE_CONCAT(a, b) GA_PROFILE_CONCAT_IMPL(a, b)
+#define GA_PROFILE_PHASE(profiler, worker, phase) \
+    ScopedPhase GA_PROFILE_CONCAT(scopedPhase, __LINE__)((profiler), (worker), (phase))
+#else
+#define GA_PROFILE_PHASE(profiler, worker, phase) ((void) 0)
+#endif
+
+
+#endif //GENETIC_ALGORITHM_PROFILER_H
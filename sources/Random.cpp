@@ -0,0 +1,45 @@
+#include <random>
+
+#include "Random.h"
+
+// Inicjalizacja stanu generatorem splitmix64 (zalecana przez autorów xoshiro)
+Random::Random(uint64_t seed) {
+    for (auto& word : s) {
+        seed += 0x9E3779B97F4A7C15ull;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        word = z ^ (z >> 31);
+    }
+}
+
+Random Random::forStream(uint64_t masterSeed, uint64_t streamIndex) {
+    Random random(masterSeed);
+    for (uint64_t i = 0; i < streamIndex; i++) {
+        random.jump();
+    }
+    return random;
+}
+
+uint64_t Random::randomSeed() {
+    random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+void Random::jump() {
+    static const uint64_t JUMP[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                    0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+
+    array<uint64_t, 4> jumped{};
+    for (uint64_t jumpWord : JUMP) {
+        for (int b = 0; b < 64; b++) {
+            if (jumpWord & (1ull << b)) {
+                for (int i = 0; i < 4; i++) {
+                    jumped[i] ^= s[i];
+                }
+            }
+            next();
+        }
+    }
+    s = jumped;
+}
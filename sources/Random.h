@@ -0,0 +1,100 @@
+#ifndef GENETIC_ALGORITHM_RANDOM_H
+#define GENETIC_ALGORITHM_RANDOM_H
+
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+// Szybki generator liczb pseudolosowych xoshiro256** (Blackman, Vigna).
+// Stan ma 32 bajty, a jedno losowanie to kilka operacji arytmetycznych.
+// Każdy wątek powinien posiadać własną instancję - strumienie kolejnych wątków
+// są rozdzielone funkcją jump() (2^128 losowań), więc nie nakładają się na siebie.
+class Random {
+public:
+    using result_type = uint64_t;
+
+    explicit Random(uint64_t seed = 0);
+
+    // Generator dla wskazanego strumienia (np. numeru wątku) wyprowadzony z ziarna głównego
+    static Random forStream(uint64_t masterSeed, uint64_t streamIndex);
+
+    // Ziarno pobrane z urządzenia losowego systemu (dla przebiegów niepowtarzalnych)
+    static uint64_t randomSeed();
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() {
+        return next();
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+
+        return result;
+    }
+
+    // Liczba całkowita z przedziału [min, max] (metoda Lemire'a, bez dzielenia w typowym przypadku)
+    int nextInt(int min, int max) {
+        const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+        return min + static_cast<int>(bounded(range));
+    }
+
+    // Liczba całkowita z przedziału [0, bound)
+    uint64_t bounded(uint64_t bound) {
+        uint64_t x = next() >> 32;
+        uint64_t m = x * bound;
+        uint64_t low = m & 0xFFFFFFFFull;
+        if (low < bound) {
+            const uint64_t threshold = (0x100000000ull - bound) % bound;
+            while (low < threshold) {
+                x = next() >> 32;
+                m = x * bound;
+                low = m & 0xFFFFFFFFull;
+            }
+        }
+        return m >> 32;
+    }
+
+    // Liczba zmiennoprzecinkowa z przedziału [0, 1)
+    double nextDouble() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    // Przesunięcie strumienia o 2^128 losowań
+    void jump();
+
+    const array<uint64_t, 4>& state() const {
+        return s;
+    }
+
+    void setState(const array<uint64_t, 4>& newState) {
+        s = newState;
+    }
+
+private:
+    array<uint64_t, 4> s{};
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_RANDOM_H
@@ -0,0 +1,158 @@
+#include <algorithm>
+
+#include "Selection.h"
+
+Selection::Method Selection::methodFromName(const string& methodName) {
+    if (methodName == "BS") {
+        return Method::BinarySearch;
+    } else if (methodName == "ALIAS") {
+        return Method::Alias;
+    } else if (methodName == "TOUR") {
+        return Method::Tournament;
+    }
+    return Method::Roulette;
+}
+
+void Selection::prepare(const int* newCosts, int newCount, const string& methodName, int newTournamentSize) {
+    prepare(newCosts, newCount, methodFromName(methodName), newTournamentSize);
+}
+
+// Metoda przygotowująca struktury selekcji dla bieżącego pokolenia
+void Selection::prepare(const int* newCosts, int newCount, Method newMethod, int newTournamentSize) {
+    costs = newCosts;
+    count = newCount;
+    tournamentSize = max(1, newTournamentSize);
+    method = newMethod;
+
+    switch (method) {
+        case Method::Roulette:
+        case Method::BinarySearch:
+            buildCumulative();
+            break;
+        case Method::Alias:
+            buildAlias();
+            break;
+        case Method::Tournament:
+            // Selekcja turniejowa porównuje koszty bezpośrednio - brak przygotowania
+            break;
+    }
+}
+
+int Selection::select(Random& random) const {
+    switch (method) {
+        case Method::BinarySearch:
+            return binarySearchRoulette(random);
+        case Method::Alias:
+            return aliasMethod(random);
+        case Method::Tournament:
+            return tournament(random);
+        default:
+            return rouletteWheel(random);
+    }
+}
+
+// Metoda do wyboru osobnika na podstawie prawdopodobieństw (metoda koła ruletki)
+int Selection::rouletteWheel(Random& random) const {
+
+    double randomValue = random.nextDouble();
+
+    // Znajdź osobnika, którego przedział zawiera wylosowaną wartość
+    for (int i = 0; i < static_cast<int>(probabilities.size()); i++) {
+
+        if (randomValue <= probabilities[i]) {
+            return i;  // Wybrano osobnika i
+        }
+    }
+
+    // Błąd zaokrąglenia sumy prawdopodobieństw - wybór ostatniego osobnika
+    return static_cast<int>(probabilities.size()) - 1;
+}
+
+// Koło ruletki z wyszukiwaniem binarnym pierwszego przedziału zawierającego wylosowaną wartość
+int Selection::binarySearchRoulette(Random& random) const {
+
+    double randomValue = random.nextDouble();
+
+    auto position = lower_bound(probabilities.begin(), probabilities.end(), randomValue);
+    if (position == probabilities.end()) {
+        --position;
+    }
+
+    return static_cast<int>(position - probabilities.begin());
+}
+
+// Budowa skumulowanych prawdopodobieństw na podstawie przystosowania (1 / koszt)
+void Selection::buildCumulative() {
+
+    probabilities.resize(count);
+
+    // Obliczenie wartości przystosowania dla każdego chromosomu w populacji
+    double fitnessSum = 0.0;
+    for (int i = 0; i < count; i++) {
+        probabilities[i] = 1.0 / costs[i];
+        fitnessSum += probabilities[i];
+    }
+
+    // Na podstawie przystosowania, obliczenie wartości prawdopodobieństwa osobnika
+    double sumOfProbabilities = 0.0;
+    for (auto& probability : probabilities) {
+        sumOfProbabilities += probability / fitnessSum;
+        probability = sumOfProbabilities;
+    }
+}
+
+// Budowa tablic aliasów metodą Vose'a
+void Selection::buildAlias() {
+
+    const int size = count;
+
+    aliasProbability.resize(size);
+    alias.resize(size);
+    scaled.resize(size);
+    small.clear();
+    large.clear();
+    small.reserve(size);
+    large.reserve(size);
+
+    double fitnessSum = 0.0;
+    for (int i = 0; i < size; i++) {
+        scaled[i] = 1.0 / costs[i];
+        fitnessSum += scaled[i];
+    }
+
+    // Prawdopodobieństwa przeskalowane tak, aby ich średnia wynosiła 1
+    for (int i = 0; i < size; i++) {
+        scaled[i] = scaled[i] * size / fitnessSum;
+        if (scaled[i] < 1.0) {
+            small.push_back(i);
+        } else {
+            large.push_back(i);
+        }
+    }
+
+    // Parowanie kolumn poniżej średniej z kolumnami powyżej średniej
+    while (!small.empty() && !large.empty()) {
+        int less = small.back();
+        small.pop_back();
+        int more = large.back();
+
+        aliasProbability[less] = scaled[less];
+        alias[less] = more;
+
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        if (scaled[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // Pozostałe kolumny (z dokładnością do błędów zaokrągleń) mają prawdopodobieństwo 1
+    for (int i : large) {
+        aliasProbability[i] = 1.0;
+        alias[i] = i;
+    }
+    for (int i : small) {
+        aliasProbability[i] = 1.0;
+        alias[i] = i;
+    }
+}
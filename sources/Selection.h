@@ -0,0 +1,91 @@
+#ifndef GENETIC_ALGORITHM_SELECTION_H
+#define GENETIC_ALGORITHM_SELECTION_H
+
+
+#include <string>
+#include <vector>
+
+#include "Random.h"
+
+using namespace std;
+
+// Selekcja rodziców. Dostępne metody:
+//  RW    - koło ruletki z liniowym przeszukaniem prawdopodobieństw skumulowanych, O(N) na losowanie
+//  BS    - koło ruletki z wyszukiwaniem binarnym w tablicy skumulowanej, O(log N) na losowanie
+//  ALIAS - metoda aliasów Vose'a, tablice budowane raz na pokolenie w O(N), O(1) na losowanie
+//  TOUR  - selekcja turniejowa (k losowych osobników, wygrywa najtańszy), bez normalizacji
+// Metoda prepare() wywoływana jest raz na pokolenie, a select() jest metodą stałą,
+// więc może być wywoływana równolegle z wielu wątków (każdy z własnym generatorem).
+class Selection {
+public:
+    enum class Method {
+        Roulette,
+        BinarySearch,
+        Alias,
+        Tournament
+    };
+
+    // Metoda selekcji na podstawie nazwy (nieznana nazwa - koło ruletki)
+    static Method methodFromName(const string& methodName);
+
+    void prepare(const int* costs, int count, const string& method, int tournamentSize);
+
+    void prepare(const int* costs, int count, Method method, int tournamentSize);
+
+    int select(Random& random) const;
+
+    // Metody wyboru pojedynczego osobnika (publiczne na potrzeby testów wydajności)
+    int rouletteWheel(Random& random) const;
+
+    int binarySearchRoulette(Random& random) const;
+
+    // Metody O(1) i O(k) zdefiniowane w nagłówku, aby mogły zostać rozwinięte w pętli selekcji
+
+    // Metoda aliasów - losowanie kolumny i rzut monetą z jej prawdopodobieństwem
+    int aliasMethod(Random& random) const {
+        const int column = static_cast<int>(random.bounded(alias.size()));
+
+        return random.nextDouble() < aliasProbability[column] ? column : alias[column];
+    }
+
+    // Selekcja turniejowa - wybór najtańszego z tournamentSize losowych osobników
+    int tournament(Random& random) const {
+        int winner = static_cast<int>(random.bounded(count));
+        for (int i = 1; i < tournamentSize; i++) {
+            int candidate = static_cast<int>(random.bounded(count));
+            if (costs[candidate] < costs[winner]) {
+                winner = candidate;
+            }
+        }
+
+        return winner;
+    }
+
+private:
+    Method method = Method::Roulette;
+
+    int tournamentSize = 2;
+
+    // Koszty osobników populacji (count kolejnych wartości)
+    const int* costs = nullptr;
+    int count = 0;
+
+    // Skumulowane prawdopodobieństwa wyboru (ruletka)
+    vector<double> probabilities;
+
+    // Tablice metody aliasów
+    vector<double> aliasProbability;
+    vector<int> alias;
+
+    // Tablice pomocnicze budowy tablic aliasów (przechowywane, aby nie alokować ich co pokolenie)
+    vector<double> scaled;
+    vector<int> small;
+    vector<int> large;
+
+    void buildCumulative();
+
+    void buildAlias();
+};
+
+
+#endif //GENETIC_ALGORITHM_SELECTION_H
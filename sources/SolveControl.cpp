@@ -0,0 +1,69 @@
+#include <limits>
+#include <thread>
+
+#include "SolveControl.h"
+
+void BestTourBoard::prepare(int newDimension) {
+    V = newDimension;
+    genes.reset(new atomic<int>[V]);
+    for (int i = 0; i < V; i++) {
+        genes[i].store(0, memory_order_relaxed);
+    }
+    bestCost.store(numeric_limits<int>::max(), memory_order_relaxed);
+    bestTime.store(0.0, memory_order_relaxed);
+    sequence.store(0, memory_order_release);
+}
+
+bool BestTourBoard::offer(int newCost, const vector<int>& tour, double elapsedTime,
+                          const ImprovementCallback& onImprovement) {
+    if (newCost >= cost()) {
+        return false;
+    }
+
+    lock_guard<mutex> lock(writerMutex);
+    if (newCost >= cost()) {
+        return false;
+    }
+
+    // Nieparzysta sekwencja oznacza trwający zapis
+    const uint64_t start = sequence.load(memory_order_relaxed);
+    sequence.store(start + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    for (int i = 0; i < V; i++) {
+        genes[i].store(tour[i], memory_order_relaxed);
+    }
+    bestCost.store(newCost, memory_order_relaxed);
+    bestTime.store(elapsedTime, memory_order_relaxed);
+
+    sequence.store(start + 2, memory_order_release);
+
+    if (onImprovement) {
+        onImprovement(newCost, tour, elapsedTime);
+    }
+    return true;
+}
+
+void BestTourBoard::read(BestSnapshot& snapshot) const {
+    snapshot.tour.resize(V);
+    while (true) {
+        const uint64_t before = sequence.load(memory_order_acquire);
+        if (before & 1) {
+            this_thread::yield();
+            continue;
+        }
+
+        for (int i = 0; i < V; i++) {
+            snapshot.tour[i] = genes[i].load(memory_order_relaxed);
+        }
+        snapshot.cost = bestCost.load(memory_order_relaxed);
+        snapshot.elapsedTime = bestTime.load(memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (sequence.load(memory_order_relaxed) == before) {
+            snapshot.version = before / 2;
+            snapshot.valid = before > 0;
+            return;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef GENETIC_ALGORITHM_SOLVECONTROL_H
+#define GENETIC_ALGORITHM_SOLVECONTROL_H
+
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// Token anulowania obliczeń - kopie tokenu współdzielą jedną flagę, więc jednym tokenem można
+// zatrzymać wiele przebiegów. Sprawdzany jest po każdym pokoleniu (jak kryterium czasu).
+class CancellationToken {
+public:
+    void cancel() const {
+        flag->store(true, memory_order_relaxed);
+    }
+
+    bool cancelled() const {
+        return flag->load(memory_order_relaxed);
+    }
+
+private:
+    shared_ptr<atomic<bool>> flag = make_shared<atomic<bool>>(false);
+};
+
+// Kopia najlepszej dotychczas trasy
+struct BestSnapshot {
+    // Czy opublikowano już jakąkolwiek trasę
+    bool valid = false;
+
+    int cost = 0;
+    vector<int> tour;
+
+    // Czas obliczeń, w którym znaleziono trasę, i numer publikacji (rośnie z każdą poprawą)
+    double elapsedTime = 0.0;
+    uint64_t version = 0;
+};
+
+// Wywołanie zwrotne po znalezieniu lepszej trasy: koszt, trasa i czas obliczeń. Wykonywane jest
+// w wątku algorytmu (wywołania są szeregowane), więc powinno być krótkie.
+using ImprovementCallback = function<void(int cost, const vector<int>& tour, double elapsedTime)>;
+
+// Tablica najlepszej trasy współdzielona przez wątki algorytmu (zapis) i kod osadzający (odczyt).
+// Zapis chroniony jest licznikiem sekwencji (seqlock): odczyt nie blokuje ani nie czeka na mutex -
+// kopiuje dane i powtarza kopię tylko wtedy, gdy w tym czasie trwał zapis. Poprawy są rzadkie,
+// więc odczyt praktycznie zawsze kończy się za pierwszym razem. Pamięć trasy przydzielana jest
+// w prepare, więc publikacja w pętli głównej nie alokuje pamięci.
+class BestTourBoard {
+public:
+    void prepare(int newDimension);
+
+    // Koszt opublikowanej trasy (INT_MAX - brak trasy)
+    int cost() const {
+        return bestCost.load(memory_order_relaxed);
+    }
+
+    // Publikacja trasy, jeśli jest lepsza od opublikowanej, wraz z wywołaniem zwrotnym (opcjonalnym).
+    // Wywołania z wielu wątków są szeregowane, więc kolejne wywołania zwrotne dostają coraz lepsze trasy
+    bool offer(int newCost, const vector<int>& tour, double elapsedTime, const ImprovementCallback& onImprovement);
+
+    // Odczyt bez blokowania (wektor trasy w snapshot jest ponownie wykorzystywany)
+    void read(BestSnapshot& snapshot) const;
+
+private:
+    int V = 0;
+    atomic<uint64_t> sequence{0};
+    atomic<int> bestCost{0};
+    atomic<double> bestTime{0.0};
+    unique_ptr<atomic<int>[]> genes;
+
+    // Szeregowanie piszących (wyspy publikują poprawy niezależnie)
+    mutex writerMutex;
+};
+
+// Powiązanie przebiegu ATSP::solve z kodem osadzającym: anulowanie, publikacja najlepszej trasy
+// i wywołanie zwrotne po poprawie (wszystkie elementy są opcjonalne)
+struct SolveControl {
+    // Token kodu osadzającego (może być współdzielony przez wiele przebiegów) oraz własna flaga
+    // zatrzymania przebiegu, która nie wpływa na inne przebiegi z tym samym tokenem
+    CancellationToken cancellation;
+    atomic<bool> stopRequested{false};
+
+    BestTourBoard* board = nullptr;
+    ImprovementCallback onImprovement;
+
+    bool cancelled() const {
+        return stopRequested.load(memory_order_relaxed) || cancellation.cancelled();
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_SOLVECONTROL_H
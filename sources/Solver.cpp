@@ -0,0 +1,110 @@
+#include <chrono>
+
+#include "Solver.h"
+
+// Zatrzymywany jest tylko własny przebieg - token przekazany w start może należeć także do innych przebiegów
+Solver::~Solver() {
+    cancel();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+bool Solver::loadInstance(const string& fileName, const DistanceOptions& options) {
+    return !rejectWhileRunning() && loaded(atsp.loadATSPFile(fileName, options));
+}
+
+bool Solver::loadMatrix(int dimension, const vector<int>& distances) {
+    return !rejectWhileRunning() && loaded(atsp.loadMatrix(dimension, distances));
+}
+
+bool Solver::loadCoordinates(vector<double> x, vector<double> y, CoordinateMetric metric) {
+    return !rejectWhileRunning() && loaded(atsp.loadCoordinates(move(x), move(y), metric));
+}
+
+bool Solver::rejectWhileRunning() {
+    const bool busy = running();
+    errorMessage = busy ? "computation is already running" : "";
+    return busy;
+}
+
+bool Solver::loaded(bool success) {
+    errorMessage = success ? "" : atsp.loadError();
+    return success;
+}
+
+bool Solver::start(const GAParameters& parameters, ImprovementCallback onImprovement,
+                   CancellationToken cancellation) {
+    if (rejectWhileRunning()) {
+        return false;
+    }
+    if (atsp.dimension() == 0) {
+        errorMessage = "no instance loaded";
+        return false;
+    }
+
+    // Parametry sprawdzane przed uruchomieniem wątku - błędna wartość nie może przerwać programu
+    if (!ATSP::checkParameters(parameters, errorMessage)) {
+        return false;
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    // Tablica przygotowywana przed uruchomieniem wątku - odczyt best jest od razu bezpieczny
+    board.prepare(atsp.dimension());
+    control.cancellation = move(cancellation);
+    control.stopRequested.store(false, memory_order_relaxed);
+    control.board = &board;
+    control.onImprovement = move(onImprovement);
+
+    started = true;
+    finished.store(false, memory_order_release);
+    worker = thread([this, parameters]() {
+        GAResult solved = atsp.solve(parameters, &control);
+        {
+            lock_guard<mutex> lock(finishMutex);
+            result = move(solved);
+            finished.store(true, memory_order_release);
+        }
+        finishCondition.notify_all();
+    });
+    return true;
+}
+
+void Solver::cancel() {
+    if (running()) {
+        control.stopRequested.store(true, memory_order_relaxed);
+    }
+}
+
+BestSnapshot Solver::best() const {
+    BestSnapshot snapshot;
+    best(snapshot);
+    return snapshot;
+}
+
+void Solver::best(BestSnapshot& snapshot) const {
+    if (!started) {
+        snapshot = BestSnapshot();
+        return;
+    }
+    board.read(snapshot);
+}
+
+bool Solver::waitFor(double seconds) {
+    if (!started) {
+        return true;
+    }
+    unique_lock<mutex> lock(finishMutex);
+    return finishCondition.wait_for(lock, chrono::duration<double>(seconds), [this]() {
+        return finished.load(memory_order_acquire);
+    });
+}
+
+GAResult Solver::wait() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    return result;
+}
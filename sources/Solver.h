@@ -0,0 +1,97 @@
+#ifndef GENETIC_ALGORITHM_SOLVER_H
+#define GENETIC_ALGORITHM_SOLVER_H
+
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ATSP.h"
+#include "SolveControl.h"
+
+using namespace std;
+
+// Interfejs do osadzania algorytmu w innych programach (np. usługach planowania tras). Instancja
+// przekazywana jest z pliku albo z pamięci, a parametry jako GAParameters - bez tekstowych argumentów
+// i wypisywania na konsolę. Obliczenia wykonywane są w wątku w tle:
+//  start  - uruchomienie obliczeń (wywołanie zwrotne po każdej poprawie najlepszej trasy)
+//  best   - najlepsza dotychczas trasa, odczytywana bez blokowania wątków algorytmu
+//  waitFor - oczekiwanie na zakończenie najwyżej podany czas (odpowiedź w terminie: po upływie
+//           terminu wystarczy odczytać best, a obliczenia mogą trwać dalej lub zostać anulowane)
+//  cancel - anulowanie obliczeń tego obiektu (wiele przebiegów naraz - przez wspólny token przekazany w start)
+//  wait   - oczekiwanie na zakończenie i pełny wynik (GAResult)
+class Solver {
+public:
+    Solver() = default;
+
+    Solver(const Solver&) = delete;
+
+    Solver& operator=(const Solver&) = delete;
+
+    // Zatrzymanie i zakończenie trwających obliczeń
+    ~Solver();
+
+    // Wczytanie instancji (tylko gdy obliczenia nie trwają; przy błędzie opis w error())
+    bool loadInstance(const string& fileName, const DistanceOptions& options = DistanceOptions());
+
+    bool loadMatrix(int dimension, const vector<int>& distances);
+
+    bool loadCoordinates(vector<double> x, vector<double> y, CoordinateMetric metric);
+
+    int dimension() const {
+        return atsp.dimension();
+    }
+
+    // Uruchomienie obliczeń w tle (false - brak instancji, niepoprawne parametry lub obliczenia już trwają,
+    // opis w error())
+    bool start(const GAParameters& parameters, ImprovementCallback onImprovement = nullptr,
+               CancellationToken cancellation = CancellationToken());
+
+    // Opis błędu ostatniego nieudanego wczytania lub uruchomienia (pusty po powodzeniu)
+    const string& error() const {
+        return errorMessage;
+    }
+
+    bool running() const {
+        return started && !finished.load(memory_order_acquire);
+    }
+
+    // Zatrzymanie obliczeń tego obiektu (token przekazany w start pozostaje nieanulowany)
+    void cancel();
+
+    // Najlepsza dotychczas trasa (snapshot.valid == false - jeszcze żadnej nie znaleziono)
+    BestSnapshot best() const;
+
+    void best(BestSnapshot& snapshot) const;
+
+    // Oczekiwanie na zakończenie najwyżej seconds sekund (true - obliczenia zakończone)
+    bool waitFor(double seconds);
+
+    // Oczekiwanie na zakończenie obliczeń i ich wynik
+    GAResult wait();
+
+private:
+    ATSP atsp;
+
+    SolveControl control;
+    BestTourBoard board;
+
+    thread worker;
+    bool started = false;
+    atomic<bool> finished{false};
+    GAResult result;
+
+    mutex finishMutex;
+    condition_variable finishCondition;
+
+    string errorMessage;
+
+    // Ustawienie opisu błędu, gdy obliczenia trwają (true - wczytanie lub uruchomienie jest odrzucane)
+    bool rejectWhileRunning();
+
+    bool loaded(bool success);
+};
+
+
+#endif //GENETIC_ALGORITHM_SOLVER_H
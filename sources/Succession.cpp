@@ -0,0 +1,241 @@
+#include <algorithm>
+
+#include "Succession.h"
+
+void Succession::prepare(int populationSize) {
+    candidates.reserve(2 * static_cast<size_t>(populationSize));
+    ranked.reserve(2 * static_cast<size_t>(populationSize));
+    duplicates.reserve(2 * static_cast<size_t>(populationSize));
+
+    // Zbiór skrótów zajęty co najwyżej w połowie (co najwyżej 2N kandydatów)
+    size_t capacity = 1;
+    while (capacity < 4 * static_cast<size_t>(populationSize)) {
+        capacity *= 2;
+    }
+    hashSet.assign(capacity, 0);
+    hashSetStamps.assign(capacity, 0);
+    epoch = 0;
+    duplicatesRejected = 0;
+}
+
+Succession::Policy Succession::policyFromName(const string& policyName) {
+    if (policyName == "PLUS") {
+        return Policy::Plus;
+    } else if (policyName == "COMMA") {
+        return Policy::Comma;
+    } else if (policyName == "STEADY") {
+        return Policy::Steady;
+    }
+    return Policy::Parents;
+}
+
+void Succession::apply(PopulationArena& arena, const vector<int>& parents, const string& policy,
+                       int replacementCount, const TourHash* hashes) {
+    apply(arena, parents, policyFromName(policy), replacementCount, hashes);
+}
+
+// Metoda do zastępowania gorszych osobników w populacji aktualnej przez lepsze z potomstwa
+void Succession::apply(PopulationArena& arena, const vector<int>& parents, Policy policy, int replacementCount,
+                       const TourHash* hashes) {
+
+    const int size = arena.populationSize();
+    candidates.clear();
+
+    if (policy == Policy::Steady) {
+        steadyState(arena, replacementCount, hashes);
+        return;
+    }
+
+    if (policy == Policy::Plus) {
+        // Populacja bieżąca i potomstwo
+        for (int i = 0; i < size; i++) {
+            candidates.push_back(arena.currentSlot(i));
+        }
+    } else if (policy == Policy::Parents) {
+        // Wybrani rodzice (z powtórzeniami) i potomstwo
+        for (int i = 0; i < size; i++) {
+            candidates.push_back(arena.currentSlot(parents[i]));
+        }
+    }
+    for (int i = 0; i < size; i++) {
+        candidates.push_back(arena.offspringSlot(i));
+    }
+
+    if (hashes != nullptr && policy != Policy::Comma) {
+        selectUnique(arena, size, *hashes);
+    } else {
+        selectBest(arena, size);
+    }
+}
+
+// Wybór count najlepszych kandydatów (selekcja częściowa) i ustanowienie ich nowym pokoleniem
+void Succession::selectBest(PopulationArena& arena, int count) {
+
+    if (static_cast<int>(candidates.size()) > count) {
+        nth_element(candidates.begin(), candidates.begin() + count, candidates.end(), [&arena](int a, int b) {
+            return arena.cost(a) < arena.cost(b);
+        });
+    }
+
+    moveBestToFront(arena, candidates, count);
+    arena.replacePopulation(candidates);
+}
+
+// Wybór count najlepszych różnych tras - kandydaci przeglądani według kosztu, a duplikat (skrót
+// trasy już wybranej) odkładany jest na koniec listy i trafia do pokolenia tylko wtedy, gdy różnych
+// kandydatów jest mniej niż count. Porządkowany jest tylko przeglądany początek listy kandydatów.
+void Succession::selectUnique(PopulationArena& arena, int count, const TourHash& hashes) {
+
+    const int total = static_cast<int>(candidates.size());
+    computeHashes(arena, candidates.data(), total, hashes);
+
+    clearHashSet();
+    ranked.clear();
+    duplicates.clear();
+    int sorted = 0;
+    int scanned = 0;
+    for (int step = count; static_cast<int>(ranked.size()) < count && scanned < total; step *= 2) {
+        sorted = sortNext(arena, sorted, step);
+        for (; scanned < sorted && static_cast<int>(ranked.size()) < count; scanned++) {
+            const int slot = candidates[scanned];
+            if (insertHash(arena.hash(slot))) {
+                ranked.push_back(slot);
+            } else {
+                duplicatesRejected++;
+                duplicates.push_back(slot);
+            }
+        }
+    }
+    ranked.insert(ranked.end(), duplicates.begin(), duplicates.end());
+    ranked.insert(ranked.end(), candidates.begin() + scanned, candidates.end());
+
+    // Zamiana buforów - pojemność obu zarezerwowano w prepare
+    candidates.swap(ranked);
+    arena.replacePopulation(candidates);
+}
+
+// Model stacjonarny - zastąpienie najgorszych osobników populacji najlepszymi potomkami
+void Succession::steadyState(PopulationArena& arena, int replacementCount, const TourHash* hashes) {
+
+    const int size = arena.populationSize();
+    int count = max(0, min(replacementCount, size));
+    auto byCost = [&arena](int a, int b) {
+        return arena.cost(a) < arena.cost(b);
+    };
+
+    // Najlepsi potomkowie na początku listy kandydatów
+    for (int i = 0; i < size; i++) {
+        candidates.push_back(arena.offspringSlot(i));
+    }
+    if (hashes == nullptr) {
+        if (count > 0 && count < size) {
+            nth_element(candidates.begin(), candidates.begin() + count, candidates.end(), byCost);
+        }
+        sort(candidates.begin(), candidates.begin() + count, byCost);
+    } else {
+        // Pominięcie potomków identycznych z osobnikiem populacji lub z lepszym potomkiem
+        vector<int>& population = arena.populationSlots();
+        computeHashes(arena, population.data(), size, *hashes);
+        computeHashes(arena, candidates.data(), size, *hashes);
+        clearHashSet();
+        for (int slot : population) {
+            insertHash(arena.hash(slot));
+        }
+
+        // Potomkowie porządkowani porcjami, dopóki brakuje przyjętych
+        int accepted = 0;
+        int sorted = 0;
+        for (int i = 0, step = count; i < size && accepted < count; step *= 2) {
+            sorted = sortNext(arena, sorted, step);
+            for (; i < sorted && accepted < count; i++) {
+                if (insertHash(arena.hash(candidates[i]))) {
+                    candidates[accepted++] = candidates[i];
+                } else {
+                    duplicatesRejected++;
+                }
+            }
+        }
+        count = accepted;
+    }
+
+    // Najgorsze osobniki populacji na końcu listy populacji (od najgorszego)
+    vector<int>& population = arena.populationSlots();
+    if (count > 0 && count < size) {
+        nth_element(population.begin(), population.end() - count, population.end(), byCost);
+    }
+    sort(population.end() - count, population.end(), [&arena](int a, int b) {
+        return arena.cost(a) > arena.cost(b);
+    });
+
+    // Para (i-ty najlepszy potomek, i-ty najgorszy osobnik) - zamiana, jeśli potomek jest lepszy
+    for (int i = 0; i < count; i++) {
+        int& worst = population[size - 1 - i];
+        if (arena.cost(candidates[i]) < arena.cost(worst)) {
+            worst = candidates[i];
+        }
+    }
+
+    candidates.assign(population.begin(), population.end());
+    moveBestToFront(arena, candidates, size);
+    arena.replacePopulation(candidates);
+}
+
+// Uporządkowanie kolejnych step kandydatów: po wywołaniu pozycje [sorted, wynik) zawierają najlepszych
+// spośród [sorted, koniec listy) w kolejności kosztu. Remis kosztów rozstrzyga numer slotu, aby wynik
+// nie zależał od implementacji sortowania.
+int Succession::sortNext(const PopulationArena& arena, int sorted, int step) {
+    auto byCost = [&arena](int a, int b) {
+        return arena.cost(a) != arena.cost(b) ? arena.cost(a) < arena.cost(b) : a < b;
+    };
+
+    const int total = static_cast<int>(candidates.size());
+    const int end = step < total - sorted ? sorted + step : total;
+    if (end < total) {
+        nth_element(candidates.begin() + sorted, candidates.begin() + end, candidates.end(), byCost);
+    }
+    sort(candidates.begin() + sorted, candidates.begin() + end, byCost);
+    return end;
+}
+
+// Przeniesienie najtańszego z count pierwszych slotów na pozycję 0
+void Succession::moveBestToFront(const PopulationArena& arena, vector<int>& slots, int count) {
+    auto best = min_element(slots.begin(), slots.begin() + count, [&arena](int a, int b) {
+        return arena.cost(a) < arena.cost(b);
+    });
+    iter_swap(slots.begin(), best);
+}
+
+// Obliczenie brakujących skrótów tras (np. populacji początkowej, migrantów lub tras poprawionych
+// przeszukiwaniem lokalnym)
+void Succession::computeHashes(PopulationArena& arena, const int* slots, int count, const TourHash& hashes) {
+    for (int i = 0; i < count; i++) {
+        const int slot = slots[i];
+        if (!arena.hasHash(slot)) {
+            arena.setHash(slot, arena.visitGenes(slot, [&hashes](const auto* genes) {
+                return hashes.hash(genes);
+            }));
+        }
+    }
+}
+
+void Succession::clearHashSet() {
+    if (++epoch == 0) {
+        fill(hashSetStamps.begin(), hashSetStamps.end(), 0);
+        epoch = 1;
+    }
+}
+
+// Dodanie skrótu do zbioru - false, jeśli skrót już w nim był
+bool Succession::insertHash(uint64_t hash) {
+    const size_t mask = hashSet.size() - 1;
+    for (size_t i = (hash ^ (hash >> 32)) & mask;; i = (i + 1) & mask) {
+        if (hashSetStamps[i] != epoch) {
+            hashSet[i] = hash;
+            hashSetStamps[i] = epoch;
+            return true;
+        }
+        if (hashSet[i] == hash) {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef GENETIC_ALGORITHM_SUCCESSION_H
+#define GENETIC_ALGORITHM_SUCCESSION_H
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PopulationArena.h"
+#include "TourHash.h"
+
+using namespace std;
+
+// Sukcesja (wybór osobników przechodzących do następnego pokolenia). Dostępne strategie:
+//  PARENTS - N najlepszych spośród wybranych rodziców i potomstwa (zachowanie pierwotne)
+//  PLUS    - strategia elitarna (mu + lambda): N najlepszych spośród populacji i potomstwa
+//  COMMA   - strategia (mu, lambda): potomstwo zastępuje całą populację
+//  STEADY  - model stacjonarny: replacementCount najlepszych potomków zastępuje
+//            najgorsze osobniki populacji, o ile są od nich lepsze
+// Zamiast pełnego sortowania 2N kandydatów używana jest selekcja częściowa (nth_element),
+// a zwycięzcy przenoszeni są do nowego pokolenia przez zmianę indeksów slotów areny.
+// Po sukcesji najlepszy osobnik populacji znajduje się zawsze na pozycji 0.
+// Z przekazanymi kluczami skrótów (TourHash) sukcesja eliminuje duplikaty: w PARENTS i PLUS do
+// pokolenia trafia N najlepszych różnych tras (duplikaty tylko wtedy, gdy różnych jest mniej niż N),
+// a w STEADY potomek identyczny z osobnikiem populacji nie jest przyjmowany. COMMA nie ma kandydatów
+// zastępczych, więc zachowuje duplikaty.
+class Succession {
+public:
+    enum class Policy {
+        Parents,
+        Plus,
+        Comma,
+        Steady
+    };
+
+    // Strategia sukcesji na podstawie nazwy (nieznana nazwa - PARENTS)
+    static Policy policyFromName(const string& policyName);
+
+    void prepare(int populationSize);
+
+    // hashes - klucze skrótów tras dla eliminacji duplikatów (nullptr - duplikaty dozwolone)
+    void apply(PopulationArena& arena, const vector<int>& parents, const string& policy, int replacementCount,
+               const TourHash* hashes = nullptr);
+
+    void apply(PopulationArena& arena, const vector<int>& parents, Policy policy, int replacementCount,
+               const TourHash* hashes = nullptr);
+
+    // Liczba duplikatów, które zostały pominięte (zastąpione gorszymi, ale różnymi trasami)
+    long long rejectedDuplicates() const {
+        return duplicatesRejected;
+    }
+
+private:
+    // Sloty kandydatów do następnego pokolenia
+    vector<int> candidates;
+
+    // Kandydaci uporządkowani przy eliminacji duplikatów i odłożone duplikaty
+    vector<int> ranked;
+    vector<int> duplicates;
+
+    // Zbiór skrótów z adresowaniem otwartym - wpis jest zajęty, jeśli jego znacznik równa się epoch,
+    // więc opróżnienie zbioru to zwiększenie epoch
+    vector<uint64_t> hashSet;
+    vector<uint32_t> hashSetStamps;
+    uint32_t epoch = 0;
+
+    long long duplicatesRejected = 0;
+
+    void selectBest(PopulationArena& arena, int count);
+
+    void selectUnique(PopulationArena& arena, int count, const TourHash& hashes);
+
+    void steadyState(PopulationArena& arena, int replacementCount, const TourHash* hashes);
+
+    int sortNext(const PopulationArena& arena, int sorted, int step);
+
+    void computeHashes(PopulationArena& arena, const int* slots, int count, const TourHash& hashes);
+
+    void clearHashSet();
+
+    bool insertHash(uint64_t hash);
+
+    static void moveBestToFront(const PopulationArena& arena, vector<int>& slots, int count);
+};
+
+
+#endif //GENETIC_ALGORITHM_SUCCESSION_H
@@ -0,0 +1,442 @@
+#include <charconv>
+#include <cmath>
+#include <cctype>
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include "TSPLIBLoader.h"
+#include "MappedFile.h"
+
+namespace {
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+    }
+
+    void skipWhitespace(const char*& position, const char* end) {
+        while (position != end && isSpace(*position)) {
+            ++position;
+        }
+    }
+
+    // Odczyt liczby zmiennoprzecinkowej (współrzędne, wagi zapisane np. jako 1.0e+06)
+    bool readDouble(const char*& position, const char* end, double& value) {
+        skipWhitespace(position, end);
+        if (position != end && *position == '+') {
+            ++position;
+        }
+        from_chars_result result = from_chars(position, end, value);
+        if (result.ec != errc()) {
+            return false;
+        }
+        position = result.ptr;
+        return true;
+    }
+
+    // Odczyt wagi krawędzi - szybka ścieżka dla liczb całkowitych,
+    // liczby z częścią ułamkową lub wykładnikiem są zaokrąglane (wartość spoza zakresu int jest błędem)
+    bool readWeight(const char*& position, const char* end, int& value) {
+        skipWhitespace(position, end);
+        if (position != end && *position == '+') {
+            ++position;
+        }
+        from_chars_result result = from_chars(position, end, value);
+        if (result.ec == errc() &&
+            (result.ptr == end || (*result.ptr != '.' && *result.ptr != 'e' && *result.ptr != 'E'))) {
+            position = result.ptr;
+            return true;
+        }
+
+        double real;
+        if (!readDouble(position, end, real)) {
+            return false;
+        }
+        const double rounded = round(real);
+        if (!(rounded >= numeric_limits<int>::min() && rounded <= numeric_limits<int>::max())) {
+            return false;
+        }
+        value = static_cast<int>(rounded);
+        return true;
+    }
+
+    // Pobranie kolejnej linii (bez znaku końca linii) i przesunięcie kursora za nią
+    string_view nextLine(const char*& position, const char* end) {
+        const char* lineBegin = position;
+        while (position != end && *position != '\n') {
+            ++position;
+        }
+        string_view line(lineBegin, static_cast<size_t>(position - lineBegin));
+        if (position != end) {
+            ++position;
+        }
+        return line;
+    }
+
+    string_view trim(string_view text) {
+        while (!text.empty() && isSpace(text.front())) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && isSpace(text.back())) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    string toUpper(string_view text) {
+        string result(text);
+        for (char& c : result) {
+            c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        }
+        return result;
+    }
+
+    bool endsWith(const string& text, const string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Pominięcie danych nieobsługiwanej sekcji (np. DISPLAY_DATA_SECTION) - do najbliższego słowa kluczowego
+    void skipSection(const char*& position, const char* end) {
+        while (true) {
+            skipWhitespace(position, end);
+            if (position == end || isalpha(static_cast<unsigned char>(*position))) {
+                return;
+            }
+            nextLine(position, end);
+        }
+    }
+
+    // Wczytanie EDGE_WEIGHT_SECTION. Formaty kolumnowe trójkątów są transpozycją formatów wierszowych,
+    // a ponieważ macierz jest wtedy symetryczna, UPPER_COL odpowiada LOWER_ROW itd.
+    bool readExplicitWeights(const char*& position, const char* end, const string& format,
+                             DistanceMatrix& matrix, string& error) {
+        const int V = matrix.dimension();
+
+        if (format.empty() || format == "FULL_MATRIX") {
+            for (int i = 0; i < V; i++) {
+                for (int j = 0; j < V; j++) {
+                    if (!readWeight(position, end, matrix.cell(i, j))) {
+                        error = position == end ? "unexpected end of EDGE_WEIGHT_SECTION" : "invalid weight";
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool upper;
+        bool withDiagonal;
+        if (format == "UPPER_ROW" || format == "LOWER_COL") {
+            upper = true;
+            withDiagonal = false;
+        } else if (format == "LOWER_ROW" || format == "UPPER_COL") {
+            upper = false;
+            withDiagonal = false;
+        } else if (format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_COL") {
+            upper = true;
+            withDiagonal = true;
+        } else if (format == "LOWER_DIAG_ROW" || format == "UPPER_DIAG_COL") {
+            upper = false;
+            withDiagonal = true;
+        } else {
+            error = "unsupported EDGE_WEIGHT_FORMAT: " + format;
+            return false;
+        }
+
+        for (int i = 0; i < V; i++) {
+            int first = upper ? (withDiagonal ? i : i + 1) : 0;
+            int last = upper ? V : (withDiagonal ? i + 1 : i);
+            for (int j = first; j < last; j++) {
+                int weight;
+                if (!readWeight(position, end, weight)) {
+                    error = position == end ? "unexpected end of EDGE_WEIGHT_SECTION" : "invalid weight";
+                    return false;
+                }
+                matrix.cell(i, j) = weight;
+                matrix.cell(j, i) = weight;
+            }
+        }
+        return true;
+    }
+
+    // Wczytanie NODE_COORD_SECTION - linie "numer x y", numeracja wierzchołków od 1
+    bool readCoordinates(const char*& position, const char* end, int dimension,
+                         vector<double>& x, vector<double>& y, string& error) {
+        x.assign(dimension, 0.0);
+        y.assign(dimension, 0.0);
+
+        for (int node = 0; node < dimension; node++) {
+            int index;
+            if (!readWeight(position, end, index)) {
+                error = position == end ? "unexpected end of NODE_COORD_SECTION" : "invalid node index";
+                return false;
+            }
+            if (index < 1 || index > dimension) {
+                error = "node index out of range in NODE_COORD_SECTION";
+                return false;
+            }
+            if (!readDouble(position, end, x[index - 1]) || !readDouble(position, end, y[index - 1])) {
+                error = "unexpected end of NODE_COORD_SECTION";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Szerokość i długość geograficzna w radianach dla typu GEO (zapis DDD.MM)
+    double geoRadians(double value) {
+        const double PI = 3.141592;
+        double degrees = static_cast<int>(value);
+        double minutes = value - degrees;
+        return PI * (degrees + 5.0 * minutes / 3.0) / 180.0;
+    }
+
+    // Wzór odległości dla typu EDGE_WEIGHT_TYPE instancji geometrycznej
+    bool coordinateMetric(const string& weightType, CoordinateMetric& metric, string& error) {
+        if (weightType == "EUC_2D") {
+            metric = CoordinateMetric::Euclidean;
+        } else if (weightType == "CEIL_2D") {
+            metric = CoordinateMetric::Ceiling;
+        } else if (weightType == "MAN_2D") {
+            metric = CoordinateMetric::Manhattan;
+        } else if (weightType == "MAX_2D") {
+            metric = CoordinateMetric::Maximum;
+        } else if (weightType == "ATT") {
+            metric = CoordinateMetric::Att;
+        } else if (weightType == "GEO") {
+            metric = CoordinateMetric::Geographic;
+        } else {
+            error = "unsupported EDGE_WEIGHT_TYPE: " + weightType;
+            return false;
+        }
+        return true;
+    }
+
+    // Liczba łuków wychodzących z miasta zapamiętywanych w postaci rzadkiej
+    int sparseSize(const DistanceOptions& options, int V) {
+        return max(0, min(options.sparseNeighbours, V - 1));
+    }
+
+    // Wczytanie EDGE_WEIGHT_SECTION w postaci rzadkiej - wiersze macierzy czytane są kolejno
+    // i z każdego zostaje k najtańszych łuków, więc pełna macierz nigdy nie jest przechowywana
+    bool readSparseWeights(const char*& position, const char* end, const string& format, int V,
+                           const DistanceOptions& options, DistanceProvider& provider, string& error) {
+        if (!format.empty() && format != "FULL_MATRIX") {
+            error = "sparse distances require EDGE_WEIGHT_FORMAT: FULL_MATRIX";
+            return false;
+        }
+
+        const int k = sparseSize(options, V);
+        vector<int> offsets(V + 1, 0);
+        vector<int> targets;
+        vector<int> weights;
+        targets.reserve(static_cast<size_t>(V) * k);
+        weights.reserve(static_cast<size_t>(V) * k);
+
+        vector<int> row(V);
+        vector<int> cities;
+        int largest = 0;
+        for (int i = 0; i < V; i++) {
+            for (int j = 0; j < V; j++) {
+                if (!readWeight(position, end, row[j])) {
+                    error = position == end ? "unexpected end of EDGE_WEIGHT_SECTION" : "invalid weight";
+                    return false;
+                }
+                if (j != i) {
+                    largest = max(largest, row[j]);
+                }
+            }
+
+            cities.clear();
+            for (int j = 0; j < V; j++) {
+                if (j != i) {
+                    cities.push_back(j);
+                }
+            }
+            partial_sort(cities.begin(), cities.begin() + k, cities.end(), [&](int a, int b) {
+                return row[a] != row[b] ? row[a] < row[b] : a < b;
+            });
+            for (int n = 0; n < k; n++) {
+                targets.push_back(cities[n]);
+                weights.push_back(row[cities[n]]);
+            }
+            offsets[i + 1] = static_cast<int>(targets.size());
+        }
+
+        const int penalty = options.sparsePenalty > 0 ? options.sparsePenalty : largest;
+        provider.useSparse(V, std::move(offsets), std::move(targets), std::move(weights), penalty);
+        return true;
+    }
+
+    // Utworzenie odległości instancji geometrycznej w wybranej postaci: pełna macierz liczona według
+    // wzorów specyfikacji TSPLIB, same współrzędne albo łuki do k najbliższych sąsiadów
+    bool computeDistances(const string& weightType, int V, vector<double>& x, vector<double>& y,
+                          const DistanceOptions& options, DistanceProvider& provider, string& error) {
+        CoordinateMetric metric;
+        if (!coordinateMetric(weightType, metric, error)) {
+            return false;
+        }
+
+        if (metric == CoordinateMetric::Geographic) {
+            for (int i = 0; i < V; i++) {
+                x[i] = geoRadians(x[i]);
+                y[i] = geoRadians(y[i]);
+            }
+        }
+        const CoordinateDistances coordinates{x.data(), y.data(), V, metric};
+
+        DistanceProvider::Storage storage = options.storage;
+        if (storage == DistanceProvider::Storage::Auto) {
+            storage = options.denseFits(V) ? DistanceProvider::Storage::Dense : DistanceProvider::Storage::Coordinates;
+        }
+
+        if (storage == DistanceProvider::Storage::Coordinates) {
+            provider.useCoordinates(V, std::move(x), std::move(y), metric);
+            return true;
+        }
+
+        if (storage == DistanceProvider::Storage::Sparse) {
+            const int k = sparseSize(options, V);
+            vector<int> targets;
+            coordinates.nearestNeighbours(k, targets);
+
+            vector<int> offsets(V + 1, 0);
+            vector<int> weights(targets.size());
+            for (int i = 0; i < V; i++) {
+                offsets[i + 1] = (i + 1) * k;
+                for (int n = i * k; n < (i + 1) * k; n++) {
+                    weights[n] = coordinates(i, targets[n]);
+                }
+            }
+
+            const int penalty = options.sparsePenalty > 0 ? options.sparsePenalty : coordinates.maximumDistance();
+            provider.useSparse(V, std::move(offsets), std::move(targets), std::move(weights), penalty);
+            return true;
+        }
+
+        DistanceMatrix& matrix = provider.useMatrix();
+        matrix.resize(V);
+        for (int i = 0; i < V; i++) {
+            for (int j = i + 1; j < V; j++) {
+                int distance = coordinates(i, j);
+                matrix.cell(i, j) = distance;
+                matrix.cell(j, i) = distance;
+            }
+        }
+        return true;
+    }
+}
+
+bool TSPLIBLoader::load(const string& fileName, DistanceProvider& provider, const DistanceOptions& options,
+                        string& error) {
+    MappedFile file;
+    if (!file.open(fileName, false, MappedFile::Access::Sequential)) {
+        error = "cannot open " + fileName;
+        return false;
+    }
+    return parse(file.data(), file.data() + file.size(), provider, options, error);
+}
+
+bool TSPLIBLoader::parse(const char* begin, const char* end, DistanceProvider& provider,
+                         const DistanceOptions& options, string& error) {
+    const char* position = begin;
+
+    int dimension = 0;
+    string weightType = "EXPLICIT";
+    string weightFormat;
+    bool weightsLoaded = false;
+    vector<double> x, y;
+
+    provider.clear();
+
+    while (position != end) {
+        string_view line = trim(nextLine(position, end));
+        if (line.empty()) {
+            continue;
+        }
+
+        // Słowo kluczowe kończy się dwukropkiem lub białym znakiem ("DIMENSION: 17", "DIMENSION : 17")
+        size_t keyLength = 0;
+        while (keyLength < line.size() && line[keyLength] != ':' && !isSpace(line[keyLength])) {
+            keyLength++;
+        }
+        string key = toUpper(line.substr(0, keyLength));
+        string_view value = line.substr(keyLength);
+        while (!value.empty() && (value.front() == ':' || isSpace(value.front()))) {
+            value.remove_prefix(1);
+        }
+
+        if (key == "EOF") {
+            break;
+        } else if (key == "DIMENSION") {
+            if (from_chars(value.data(), value.data() + value.size(), dimension).ec != errc() || dimension < 2) {
+                error = "invalid DIMENSION";
+                return false;
+            }
+        } else if (key == "EDGE_WEIGHT_TYPE") {
+            weightType = toUpper(value);
+        } else if (key == "EDGE_WEIGHT_FORMAT") {
+            weightFormat = toUpper(value);
+        } else if (key == "EDGE_WEIGHT_SECTION" || key == "NODE_COORD_SECTION") {
+            if (dimension <= 0) {
+                error = "missing DIMENSION before " + key;
+                return false;
+            }
+            // Dane sekcji mogą zaczynać się już w linii ze słowem kluczowym
+            position = value.data();
+
+            if (key == "EDGE_WEIGHT_SECTION") {
+                // Jawne wagi nie mają współrzędnych - macierz albo (gdy się nie mieści) łuki rzadkie
+                DistanceProvider::Storage storage = options.storage;
+                if (storage == DistanceProvider::Storage::Auto) {
+                    storage = options.denseFits(dimension) ? DistanceProvider::Storage::Dense
+                                                           : DistanceProvider::Storage::Sparse;
+                }
+                if (storage == DistanceProvider::Storage::Coordinates) {
+                    error = "coordinate distances require NODE_COORD_SECTION";
+                    return false;
+                }
+
+                if (storage == DistanceProvider::Storage::Sparse) {
+                    if (!readSparseWeights(position, end, weightFormat, dimension, options, provider, error)) {
+                        return false;
+                    }
+                } else {
+                    DistanceMatrix& matrix = provider.useMatrix();
+                    matrix.resize(dimension);
+                    if (!readExplicitWeights(position, end, weightFormat, matrix, error)) {
+                        return false;
+                    }
+                }
+                weightsLoaded = true;
+            } else if (!readCoordinates(position, end, dimension, x, y, error)) {
+                return false;
+            }
+        } else if (endsWith(key, "_SECTION")) {
+            position = value.data();
+            skipSection(position, end);
+        }
+        // Pozostałe słowa kluczowe (NAME, TYPE, COMMENT, ...) nie wpływają na macierz odległości
+    }
+
+    if (!weightsLoaded) {
+        if (x.empty()) {
+            error = dimension <= 0 ? "missing DIMENSION" : "missing EDGE_WEIGHT_SECTION or NODE_COORD_SECTION";
+            return false;
+        }
+        if (!computeDistances(weightType, dimension, x, y, options, provider, error)) {
+            provider.clear();
+            return false;
+        }
+    }
+
+    // Ustawianie -1 na głównej przekątnej (pozostałe postacie zwracają -1 dla from == to)
+    if (provider.storage() == DistanceProvider::Storage::Dense) {
+        DistanceMatrix& matrix = provider.useMatrix();
+        for (int i = 0; i < dimension; i++) {
+            matrix.cell(i, i) = -1;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef GENETIC_ALGORITHM_TSPLIBLOADER_H
+#define GENETIC_ALGORITHM_TSPLIBLOADER_H
+
+
+#include <string>
+
+#include "DistanceProvider.h"
+
+using namespace std;
+
+// Wczytywanie instancji w formacie TSPLIB bezpośrednio do płaskiej macierzy odległości
+// albo (zgodnie z DistanceOptions) do współrzędnych lub rzadkiego zbioru łuków.
+// Plik jest odwzorowywany w pamięci, a liczby parsowane przez from_chars (bez strumieni i kopii).
+// Obsługiwane są:
+// - EDGE_WEIGHT_TYPE: EXPLICIT z formatami FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW,
+//   LOWER_DIAG_ROW, UPPER_COL, LOWER_COL, UPPER_DIAG_COL, LOWER_DIAG_COL,
+// - EDGE_WEIGHT_TYPE: EUC_2D, CEIL_2D, MAN_2D, MAX_2D, ATT, GEO (odległości liczone ze współrzędnych).
+// Na głównej przekątnej ustawiane jest -1, tak jak w pierwotnym wczytywaniu plików .atsp.
+// Postać rzadka dla jawnych wag wymaga formatu FULL_MATRIX (wiersze czytane są kolejno).
+class TSPLIBLoader {
+public:
+    // Wczytanie pliku - w przypadku błędu zwracany jest false, a opis trafia do error
+    static bool load(const string& fileName, DistanceProvider& provider, const DistanceOptions& options,
+                     string& error);
+
+    // Parsowanie zawartości pliku znajdującej się już w pamięci
+    static bool parse(const char* begin, const char* end, DistanceProvider& provider,
+                      const DistanceOptions& options, string& error);
+};
+
+
+#endif //GENETIC_ALGORITHM_TSPLIBLOADER_H
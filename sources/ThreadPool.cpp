@@ -0,0 +1,85 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount) : threadCount(threadCount < 1 ? 1 : threadCount) {
+    // Wątek wywołujący jest pierwszym wątkiem roboczym, więc tworzymy o jeden mniej
+    for (int worker = 1; worker < this->threadCount; worker++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(int count, void* context, TaskFunction task) {
+    // Wersja jednowątkowa - bez synchronizacji
+    if (threadCount == 1) {
+        task(context, 0, count, 0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(stateMutex);
+        currentTask = task;
+        currentContext = context;
+        currentCount = count;
+        pendingWorkers = threadCount - 1;
+        taskGeneration++;
+    }
+    taskAvailable.notify_all();
+
+    // Fragment 0 wykonuje wątek wywołujący
+    runChunk(0);
+
+    // Oczekiwanie na zakończenie pozostałych fragmentów
+    unique_lock<mutex> lock(stateMutex);
+    taskFinished.wait(lock, [this] { return pendingWorkers == 0; });
+    currentTask = nullptr;
+    currentContext = nullptr;
+}
+
+int ThreadPool::hardwareThreads() {
+    unsigned int count = thread::hardware_concurrency();
+    return count == 0 ? 1 : static_cast<int>(count);
+}
+
+void ThreadPool::workerLoop(int worker) {
+    unsigned long long seenGeneration = 0;
+
+    while (true) {
+        {
+            unique_lock<mutex> lock(stateMutex);
+            taskAvailable.wait(lock, [&] { return stopping || taskGeneration != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = taskGeneration;
+        }
+
+        runChunk(worker);
+
+        {
+            lock_guard<mutex> lock(stateMutex);
+            pendingWorkers--;
+        }
+        taskFinished.notify_one();
+    }
+}
+
+// Wykonanie fragmentu zakresu przypisanego do wątku o numerze worker
+void ThreadPool::runChunk(int worker) const {
+    const long long begin = static_cast<long long>(currentCount) * worker / threadCount;
+    const long long end = static_cast<long long>(currentCount) * (worker + 1) / threadCount;
+
+    if (begin < end) {
+        currentTask(currentContext, static_cast<int>(begin), static_cast<int>(end), worker);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef GENETIC_ALGORITHM_THREADPOOL_H
+#define GENETIC_ALGORITHM_THREADPOOL_H
+
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// Prosta pula wątków do równoległego wykonywania pętli.
+// Zakres [0, count) dzielony jest statycznie na tyle fragmentów, ile jest wątków,
+// a fragment o numerze w zawsze trafia do wywołania z worker = w. Dzięki temu
+// przypisanie pracy (i strumieni liczb losowych) nie zależy od szeregowania wątków.
+// Wątek wywołujący wykonuje fragment 0, pozostałe wykonują wątki puli.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return threadCount;
+    }
+
+    // Wywołanie task(begin, end, worker) dla każdego fragmentu i oczekiwanie na zakończenie wszystkich.
+    // Zadanie przekazywane jest przez wskaźnik (bez std::function), więc wywołanie nie alokuje pamięci.
+    template<typename Task>
+    void parallelFor(int count, Task&& task) {
+        using TaskType = typename remove_reference<Task>::type;
+        run(count, const_cast<void*>(static_cast<const void*>(&task)), [](void* context, int begin, int end, int worker) {
+            (*static_cast<TaskType*>(context))(begin, end, worker);
+        });
+    }
+
+    // Liczba wątków sprzętowych (co najmniej 1)
+    static int hardwareThreads();
+
+private:
+    int threadCount;
+
+    vector<thread> workers;
+
+    mutex stateMutex;
+    condition_variable taskAvailable;
+    condition_variable taskFinished;
+
+    using TaskFunction = void (*)(void* context, int begin, int end, int worker);
+
+    TaskFunction currentTask = nullptr;
+    void* currentContext = nullptr;
+    int currentCount = 0;
+
+    // Numer bieżącego zadania (pozwala wątkom odróżnić nowe zadanie od poprzedniego)
+    unsigned long long taskGeneration = 0;
+    int pendingWorkers = 0;
+    bool stopping = false;
+
+    void run(int count, void* context, TaskFunction task);
+
+    void workerLoop(int worker);
+
+    void runChunk(int worker) const;
+};
+
+
+#endif //GENETIC_ALGORITHM_THREADPOOL_H
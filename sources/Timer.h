@@ -0,0 +1,35 @@
+#ifndef GENETIC_ALGORITHM_TIMER_H
+#define GENETIC_ALGORITHM_TIMER_H
+
+
+#include <chrono>
+
+using namespace std;
+
+// Przenośny pomiar czasu oparty na zegarze monotonicznym (steady_clock),
+// niezależny od zmian czasu systemowego
+class Timer {
+public:
+    Timer() : start(chrono::steady_clock::now()) {}
+
+    // Rozpoczęcie pomiaru od nowa
+    void restart() {
+        start = chrono::steady_clock::now();
+    }
+
+    // Czas od rozpoczęcia pomiaru w sekundach
+    double elapsedSeconds() const {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    // Bieżący odczyt zegara w nanosekundach (do mierzenia krótkich odcinków)
+    static long long nanoseconds() {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    chrono::steady_clock::time_point start;
+};
+
+
+#endif //GENETIC_ALGORITHM_TIMER_H
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "TourBuilder.h"
+
+TourBuilder::Method TourBuilder::methodFromName(const string& methodName) {
+    if (methodName == "NN") {
+        return Method::NearestNeighbour;
+    } else if (methodName == "GREEDY") {
+        return Method::Greedy;
+    } else if (methodName == "INSERTION") {
+        return Method::Insertion;
+    } else if (methodName == "MIX") {
+        return Method::Mix;
+    }
+    return Method::Random;
+}
+
+TourBuilder::Method TourBuilder::methodFor(Method method, int index) {
+    if (method != Method::Mix) {
+        return method;
+    }
+    static const Method MixedMethods[] = {Method::NearestNeighbour, Method::Greedy, Method::Insertion};
+    return MixedMethods[index % 3];
+}
+
+void TourBuilder::prepare(int newDimension) {
+    V = newDimension;
+    unvisited.resize(V);
+    unvisitedPosition.resize(V);
+    next.resize(V);
+    previous.resize(V);
+    parent.resize(V);
+    order.resize(V);
+}
+
+template<typename Distances, typename Gene>
+void TourBuilder::build(Method method, const Distances& distances, const CandidateLists& candidates, Gene* tour,
+                        Random& random, double noise) {
+    switch (method) {
+        case Method::Greedy:
+            greedy(distances, candidates, tour, random, noise);
+            break;
+        case Method::Insertion:
+            insertion(distances, candidates, tour, random);
+            break;
+        default:
+            nearestNeighbour(distances, candidates, tour, random);
+            break;
+    }
+}
+
+// Losowy najbliższy sąsiad - najbliższy nieodwiedzony następnik z listy kandydatów, a gdy wszyscy
+// kandydaci są już w trasie - najbliższe z nieodwiedzonych miast (przegląd listy nieodwiedzonych)
+template<typename Distances, typename Gene>
+void TourBuilder::nearestNeighbour(const Distances& distances, const CandidateLists& candidates, Gene* tour,
+                                   Random& random) {
+    resetUnvisited();
+
+    int current = random.nextInt(0, V - 1);
+    visit(current);
+    tour[0] = static_cast<Gene>(current);
+
+    for (int step = 1; step < V; step++) {
+        int first = -1;
+        int second = -1;
+        const int* successors = candidates.nearestSuccessors(current);
+        for (int i = 0; i < candidates.size(); i++) {
+            if (unvisitedPosition[successors[i]] >= 0) {
+                if (first < 0) {
+                    first = successors[i];
+                } else {
+                    second = successors[i];
+                    break;
+                }
+            }
+        }
+
+        if (first < 0) {
+            first = unvisited[0];
+            int bestDistance = distances(current, first);
+            for (size_t i = 1; i < unvisited.size(); i++) {
+                const int distance = distances(current, unvisited[i]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    first = unvisited[i];
+                }
+            }
+        }
+
+        // Co ósmy krok (średnio) drugi najbliższy następnik - kolejne trasy różnią się od siebie
+        if (second >= 0 && random.nextInt(0, 7) == 0) {
+            first = second;
+        }
+
+        visit(first);
+        tour[step] = static_cast<Gene>(first);
+        current = first;
+    }
+}
+
+// Zachłanne dobieranie łuków z list kandydatów. Łuk (from, to) jest przyjmowany, jeśli from nie ma
+// jeszcze następnika, to nie ma poprzednika i oba miasta należą do różnych ścieżek (brak podcyklu).
+// Ścieżki łączone są w trasę od losowej ścieżki, dołączając zawsze ścieżkę o najbliższym początku
+template<typename Distances, typename Gene>
+void TourBuilder::greedy(const Distances& distances, const CandidateLists& candidates, Gene* tour, Random& random,
+                         double noise) {
+    arcs.clear();
+    for (int from = 0; from < V; from++) {
+        const int* successors = candidates.nearestSuccessors(from);
+        for (int i = 0; i < candidates.size(); i++) {
+            const double cost = distances(from, successors[i]);
+            arcs.push_back(Arc{noise > 0.0 ? cost * (1.0 + noise * random.nextDouble()) : cost, from, successors[i]});
+        }
+    }
+    sort(arcs.begin(), arcs.end(), [](const Arc& a, const Arc& b) {
+        if (a.key != b.key) {
+            return a.key < b.key;
+        }
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+
+    fill(next.begin(), next.end(), -1);
+    fill(previous.begin(), previous.end(), -1);
+    iota(parent.begin(), parent.end(), 0);
+
+    for (const Arc& arc : arcs) {
+        if (next[arc.from] < 0 && previous[arc.to] < 0) {
+            const int fromPath = find(arc.from);
+            const int toPath = find(arc.to);
+            if (fromPath != toPath) {
+                next[arc.from] = arc.to;
+                previous[arc.to] = arc.from;
+                parent[fromPath] = toPath;
+            }
+        }
+    }
+
+    // Lista początków ścieżek (pojedyncze miasta bez przyjętych łuków są ścieżkami jednoelementowymi)
+    unvisited.clear();
+    for (int city = 0; city < V; city++) {
+        unvisitedPosition[city] = -1;
+        if (previous[city] < 0) {
+            unvisitedPosition[city] = static_cast<int>(unvisited.size());
+            unvisited.push_back(city);
+        }
+    }
+
+    int head = unvisited[random.nextInt(0, static_cast<int>(unvisited.size()) - 1)];
+    int position = 0;
+    while (true) {
+        visit(head);
+        int tail = head;
+        tour[position++] = static_cast<Gene>(tail);
+        while (next[tail] >= 0) {
+            tail = next[tail];
+            tour[position++] = static_cast<Gene>(tail);
+        }
+        if (unvisited.empty()) {
+            break;
+        }
+
+        head = unvisited[0];
+        int bestDistance = distances(tail, head);
+        for (size_t i = 1; i < unvisited.size(); i++) {
+            const int distance = distances(tail, unvisited[i]);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                head = unvisited[i];
+            }
+        }
+    }
+}
+
+// Wstawianie miast w losowej kolejności w najtańsze miejsce trasy. Sprawdzane są miejsca za bliskimi
+// poprzednikami i przed bliskimi następnikami wstawianego miasta, a jeśli żaden z nich nie jest jeszcze
+// w trasie - wszystkie miejsca. Trasa przechowywana jest jako lista dwukierunkowa (next, previous)
+template<typename Distances, typename Gene>
+void TourBuilder::insertion(const Distances& distances, const CandidateLists& candidates, Gene* tour,
+                            Random& random) {
+    iota(order.begin(), order.end(), 0);
+    for (int i = V - 1; i > 0; i--) {
+        swap(order[i], order[random.nextInt(0, i)]);
+    }
+    if (V < 2) {
+        tour[0] = static_cast<Gene>(order[0]);
+        return;
+    }
+
+    fill(next.begin(), next.end(), -1);
+    fill(previous.begin(), previous.end(), -1);
+    next[order[0]] = previous[order[0]] = order[1];
+    next[order[1]] = previous[order[1]] = order[0];
+
+    for (int index = 2; index < V; index++) {
+        const int city = order[index];
+        int bestAfter = -1;
+        long long bestChange = numeric_limits<long long>::max();
+        auto consider = [&](int after) {
+            const int before = next[after];
+            const long long change = static_cast<long long>(distances(after, city)) + distances(city, before) -
+                                     distances(after, before);
+            if (change < bestChange) {
+                bestChange = change;
+                bestAfter = after;
+            }
+        };
+
+        const int* predecessors = candidates.nearestPredecessors(city);
+        const int* successors = candidates.nearestSuccessors(city);
+        for (int i = 0; i < candidates.size(); i++) {
+            if (next[predecessors[i]] >= 0) {
+                consider(predecessors[i]);
+            }
+            if (next[successors[i]] >= 0) {
+                consider(previous[successors[i]]);
+            }
+        }
+        if (bestAfter < 0) {
+            for (int i = 0; i < index; i++) {
+                consider(order[i]);
+            }
+        }
+
+        const int following = next[bestAfter];
+        next[bestAfter] = city;
+        previous[city] = bestAfter;
+        next[city] = following;
+        previous[following] = city;
+    }
+
+    int city = order[0];
+    for (int i = 0; i < V; i++) {
+        tour[i] = static_cast<Gene>(city);
+        city = next[city];
+    }
+}
+
+void TourBuilder::resetUnvisited() {
+    unvisited.resize(V);
+    iota(unvisited.begin(), unvisited.end(), 0);
+    iota(unvisitedPosition.begin(), unvisitedPosition.end(), 0);
+}
+
+// Usunięcie miasta z listy nieodwiedzonych (zamiana z ostatnim elementem)
+void TourBuilder::visit(int city) {
+    const int position = unvisitedPosition[city];
+    if (position < 0) {
+        return;
+    }
+    const int last = unvisited.back();
+    unvisited[position] = last;
+    unvisitedPosition[last] = position;
+    unvisited.pop_back();
+    unvisitedPosition[city] = -1;
+}
+
+// Reprezentant zbioru rozłącznego (z kompresją ścieżki przez połowienie)
+int TourBuilder::find(int city) {
+    while (parent[city] != city) {
+        parent[city] = parent[parent[city]];
+        city = parent[city];
+    }
+    return city;
+}
+
+// Konkretyzacje dla widoków macierzy o elementach 16- i 32-bitowych, współrzędnych i łuków rzadkich
+// oraz genów uint16_t i int
+template void TourBuilder::build(Method, const DistanceView<int16_t>&, const CandidateLists&, uint16_t*, Random&,
+                                 double);
+
+template void TourBuilder::build(Method, const DistanceView<int16_t>&, const CandidateLists&, int*, Random&,
+                                 double);
+
+template void TourBuilder::build(Method, const DistanceView<int32_t>&, const CandidateLists&, uint16_t*, Random&,
+                                 double);
+
+template void TourBuilder::build(Method, const DistanceView<int32_t>&, const CandidateLists&, int*, Random&,
+                                 double);
+
+template void TourBuilder::build(Method, const CoordinateDistances&, const CandidateLists&, uint16_t*, Random&,
+                                 double);
+
+template void TourBuilder::build(Method, const CoordinateDistances&, const CandidateLists&, int*, Random&, double);
+
+template void TourBuilder::build(Method, const SparseDistances&, const CandidateLists&, uint16_t*, Random&,
+                                 double);
+
+template void TourBuilder::build(Method, const SparseDistances&, const CandidateLists&, int*, Random&, double);
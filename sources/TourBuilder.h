@@ -0,0 +1,89 @@
+#ifndef GENETIC_ALGORITHM_TOURBUILDER_H
+#define GENETIC_ALGORITHM_TOURBUILDER_H
+
+
+#include <string>
+#include <vector>
+
+#include "LocalSearch.h"
+#include "Random.h"
+
+using namespace std;
+
+// Heurystyki konstrukcyjne tras dla populacji początkowej (zamiast tras losowych):
+//  NN        - losowy najbliższy sąsiad: losowe miasto początkowe, a w kolejnych krokach
+//              najbliższy nieodwiedzony następnik (z małym prawdopodobieństwem drugi najbliższy)
+//  GREEDY    - zachłanne dobieranie łuków: łuki z list kandydatów od najtańszego, o ile nie
+//              tworzą rozgałęzienia ani podcyklu; powstałe ścieżki łączone są od najbliższej
+//  INSERTION - wstawianie miast w losowej kolejności w najtańsze miejsce trasy (sprawdzane są
+//              miejsca obok bliskich sąsiadów z list kandydatów)
+//  MIX       - kolejne trasy budowane na zmianę trzema powyższymi heurystykami
+// Wszystkie heurystyki korzystają z list kandydatów, więc działają w czasie bliskim O(V * k)
+// także dla odległości liczonych ze współrzędnych i łuków rzadkich.
+// Obiekt przechowuje bufory robocze, więc każdy wątek powinien mieć własną instancję.
+class TourBuilder {
+public:
+    enum class Method {
+        Random,
+        NearestNeighbour,
+        Greedy,
+        Insertion,
+        Mix
+    };
+
+    // Metoda na podstawie nazwy: RANDOM, NN, GREEDY, INSERTION, MIX (nieznana nazwa - RANDOM)
+    static Method methodFromName(const string& methodName);
+
+    // Heurystyka dla index-tej trasy budowanej metodą method (MIX - kolejne heurystyki na zmianę)
+    static Method methodFor(Method method, int index);
+
+    void prepare(int newDimension);
+
+    // Budowa trasy wskazaną heurystyką. noise > 0 losowo zaburza koszty łuków w metodzie GREEDY
+    // (np. 0.1 - do 10%), aby kolejne trasy różniły się od siebie.
+    // Szablon widoku odległości i typu genu - konkretyzacje w TourBuilder.cpp
+    template<typename Distances, typename Gene>
+    void build(Method method, const Distances& distances, const CandidateLists& candidates, Gene* tour,
+               Random& random, double noise);
+
+private:
+    int V = 0;
+
+    // Miasta jeszcze nieodwiedzone (lista z usuwaniem przez zamianę z ostatnim elementem)
+    vector<int> unvisited;
+    vector<int> unvisitedPosition;
+
+    // Następnik i poprzednik miasta w budowanej trasie lub ścieżce (-1 - brak)
+    vector<int> next;
+    vector<int> previous;
+
+    // Zbiory rozłączne ścieżek metody GREEDY i kolejność wstawiania metody INSERTION
+    vector<int> parent;
+    vector<int> order;
+
+    struct Arc {
+        double key;
+        int from;
+        int to;
+    };
+    vector<Arc> arcs;
+
+    template<typename Distances, typename Gene>
+    void nearestNeighbour(const Distances& distances, const CandidateLists& candidates, Gene* tour, Random& random);
+
+    template<typename Distances, typename Gene>
+    void greedy(const Distances& distances, const CandidateLists& candidates, Gene* tour, Random& random,
+                double noise);
+
+    template<typename Distances, typename Gene>
+    void insertion(const Distances& distances, const CandidateLists& candidates, Gene* tour, Random& random);
+
+    void resetUnvisited();
+
+    void visit(int city);
+
+    int find(int city);
+};
+
+
+#endif //GENETIC_ALGORITHM_TOURBUILDER_H
@@ -0,0 +1,84 @@
+#include <algorithm>
+
+#include "TourHash.h"
+#include "Random.h"
+
+void TourHash::prepare(int newDimension) {
+    V = newDimension;
+
+    // Stałe ziarno - skróty nie zależą od ziarna przebiegu ani od wyspy
+    Random random(0x5DEECE66Dull);
+    fromKeys.resize(V);
+    toKeys.resize(V);
+    checkFromKeys.resize(V);
+    checkToKeys.resize(V);
+    for (int city = 0; city < V; city++) {
+        fromKeys[city] = random.next();
+        toKeys[city] = random.next() | 1;
+    }
+    for (int city = 0; city < V; city++) {
+        checkFromKeys[city] = random.next();
+        checkToKeys[city] = random.next() | 1;
+    }
+}
+
+void CostCache::prepare(int capacity) {
+    entries.clear();
+    clock = 0;
+    if (capacity <= 0) {
+        setShift = 64;
+        return;
+    }
+
+    // Liczba zbiorów - potęga dwójki, zbiór wybierany setBits najstarszymi bitami skrótu
+    int setBits = 0;
+    while ((static_cast<long long>(Ways) << setBits) < capacity) {
+        setBits++;
+    }
+    setShift = 64 - setBits;
+    entries.assign(static_cast<size_t>(Ways) << setBits, Entry());
+}
+
+bool CostCache::find(uint64_t hash, uint64_t check, int& cost) {
+    if (entries.empty()) {
+        return false;
+    }
+    Entry* ways = set(hash);
+    for (int i = 0; i < Ways; i++) {
+        if (ways[i].stamp != 0 && ways[i].hash == hash && ways[i].check == check) {
+            ways[i].stamp = ++clock;
+            cost = ways[i].cost;
+            return true;
+        }
+    }
+    return false;
+}
+
+void CostCache::insert(uint64_t hash, uint64_t check, int cost) {
+    if (entries.empty()) {
+        return;
+    }
+
+    // Przepełnienie licznika - wyczyszczenie pamięci (raz na 2^32 użyć)
+    if (clock == UINT32_MAX) {
+        fill(entries.begin(), entries.end(), Entry());
+        clock = 0;
+    }
+
+    // Istniejący wpis jest odświeżany, w przeciwnym razie zastępowany jest wpis najdawniej używany
+    Entry* ways = set(hash);
+    Entry* victim = ways;
+    for (int i = 0; i < Ways; i++) {
+        if (ways[i].stamp != 0 && ways[i].hash == hash) {
+            victim = ways + i;
+            break;
+        }
+        if (ways[i].stamp < victim->stamp) {
+            victim = ways + i;
+        }
+    }
+    victim->hash = hash;
+    victim->check = check;
+    victim->cost = cost;
+    victim->stamp = ++clock;
+}
@@ -0,0 +1,112 @@
+#ifndef GENETIC_ALGORITHM_TOURHASH_H
+#define GENETIC_ALGORITHM_TOURHASH_H
+
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Skrót trasy w stylu Zobrista - XOR kluczy wszystkich łuków cyklu. Klucz łuku (from, to) to iloczyn
+// losowych kluczy miasta początkowego i końcowego przepuszczony przez funkcję mieszającą (fmix64
+// z MurmurHash3 - bez niej najmłodsze bity iloczynu zależałyby tylko od najmłodszych bitów kluczy,
+// a bit 0 byłby stały), więc tablice mają 2 * V elementów zamiast V * V.
+// Skrót nie zależy od miasta, od którego zapisano cykl, a ruch zmieniający kilka łuków uaktualnia
+// go w czasie O(1) (XOR kluczy usuniętych i dodanych łuków). Skrót kontrolny (check) liczony jest
+// tak samo, ale z osobnym zestawem kluczy miast, więc jest od skrótu niezależny.
+class TourHash {
+public:
+    // Klucze dla problemu o V miastach (stałe ziarno - ta sama trasa ma zawsze ten sam skrót)
+    void prepare(int newDimension);
+
+    bool empty() const {
+        return V == 0;
+    }
+
+    uint64_t arc(int from, int to) const {
+        return mix(fromKeys[from] * toKeys[to]);
+    }
+
+    template<typename Gene>
+    uint64_t hash(const Gene* tour) const {
+        uint64_t result = arc(tour[V - 1], tour[0]);
+        for (int i = 0; i < V - 1; i++) {
+            result ^= arc(tour[i], tour[i + 1]);
+        }
+        return result;
+    }
+
+    // Skrót kontrolny trasy (O(V), bez aktualizacji przy ruchach - liczony tylko przy pamięci kosztów)
+    template<typename Gene>
+    uint64_t check(const Gene* tour) const {
+        uint64_t result = mix(checkFromKeys[tour[V - 1]] * checkToKeys[tour[0]]);
+        for (int i = 0; i < V - 1; i++) {
+            result ^= mix(checkFromKeys[tour[i]] * checkToKeys[tour[i + 1]]);
+        }
+        return result;
+    }
+
+private:
+    int V = 0;
+    vector<uint64_t> fromKeys;
+
+    // Klucze nieparzyste, aby iloczyn nie tracił bitów klucza miasta początkowego
+    vector<uint64_t> toKeys;
+
+    vector<uint64_t> checkFromKeys;
+    vector<uint64_t> checkToKeys;
+
+    static uint64_t mix(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDull;
+        key ^= key >> 33;
+        key *= 0xC4CEB9FE1A85EC53ull;
+        key ^= key >> 33;
+        return key;
+    }
+};
+
+// Ograniczona pamięć podręczna kosztów tras indeksowana skrótem. Wpisy pogrupowane są w zbiory
+// po Ways elementów (zbiór wybierany starszymi bitami skrótu); w zbiorze wymieniany jest najdawniej
+// używany wpis (LRU). Wpis przechowuje także skrót kontrolny trasy - trafienie wymaga zgodności
+// obu niezależnych skrótów, więc kolizja samego skrótu nie zwraca błędnego kosztu. Oba skróty nie
+// zależą od miasta początkowego, więc obrócony zapis tego samego cyklu także trafia w pamięć.
+// Pamięć przydzielana jest raz, w prepare, więc pętla główna nie alokuje pamięci.
+// Obiekt nie jest chroniony blokadą - każdy wątek roboczy ma własną instancję.
+class CostCache {
+public:
+    static constexpr int Ways = 4;
+
+    // Pojemność zaokrąglana w górę do potęgi dwójki (0 - pamięć wyłączona)
+    void prepare(int capacity);
+
+    bool enabled() const {
+        return !entries.empty();
+    }
+
+    // check - skrót kontrolny trasy (TourHash::check)
+    bool find(uint64_t hash, uint64_t check, int& cost);
+
+    void insert(uint64_t hash, uint64_t check, int cost);
+
+private:
+    struct Entry {
+        uint64_t hash = 0;
+        uint64_t check = 0;
+        int cost = 0;
+
+        // Chwila ostatniego użycia (0 - wpis pusty)
+        uint32_t stamp = 0;
+    };
+
+    vector<Entry> entries;
+    int setShift = 64;
+    uint32_t clock = 0;
+
+    Entry* set(uint64_t hash) {
+        return entries.data() + (setShift < 64 ? (hash >> setShift) * Ways : 0);
+    }
+};
+
+
+#endif //GENETIC_ALGORITHM_TOURHASH_H
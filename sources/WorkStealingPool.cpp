@@ -0,0 +1,100 @@
+#include "WorkStealingPool.h"
+
+namespace {
+
+    // Pula i numer wątku wykonującego bieżące zadanie (-1 - wątek spoza puli)
+    thread_local const WorkStealingPool* currentPool = nullptr;
+    thread_local int currentWorker = -1;
+}
+
+WorkStealingPool::WorkStealingPool(int threadCount) {
+    const int count = threadCount < 1 ? 1 : threadCount;
+    queues.resize(count);
+    for (int worker = 0; worker < count; worker++) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, worker);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    lock_guard<mutex> lock(stateMutex);
+    if (currentPool == this) {
+        queues[currentWorker].push_back(std::move(task));
+    } else {
+        injected.push_back(std::move(task));
+    }
+    pendingTasks++;
+    queuedTasks++;
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    unique_lock<mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pendingTasks == 0; });
+}
+
+// Pobranie zadania: najnowsze z własnej kolejki, najstarsze ze wspólnej, najstarsze z kolejki
+// innego wątku (przeglądanej od następnego wątku). Wywoływane pod stateMutex.
+bool WorkStealingPool::take(int worker, Task& task) {
+    deque<Task>& own = queues[worker];
+    if (!own.empty()) {
+        task = std::move(own.back());
+        own.pop_back();
+        return true;
+    }
+
+    if (!injected.empty()) {
+        task = std::move(injected.front());
+        injected.pop_front();
+        return true;
+    }
+
+    const int count = static_cast<int>(queues.size());
+    for (int offset = 1; offset < count; offset++) {
+        deque<Task>& victim = queues[(worker + offset) % count];
+        if (!victim.empty()) {
+            task = std::move(victim.front());
+            victim.pop_front();
+            stolenTasks.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    currentPool = this;
+    currentWorker = worker;
+
+    while (true) {
+        Task task;
+        {
+            unique_lock<mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this] { return stopping || queuedTasks > 0; });
+            if (queuedTasks == 0) {
+                return;
+            }
+            take(worker, task);
+            queuedTasks--;
+        }
+
+        task(worker);
+        task = nullptr;
+
+        lock_guard<mutex> lock(stateMutex);
+        if (--pendingTasks == 0) {
+            allDone.notify_all();
+        }
+    }
+}
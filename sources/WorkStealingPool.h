@@ -0,0 +1,73 @@
+#ifndef GENETIC_ALGORITHM_WORKSTEALINGPOOL_H
+#define GENETIC_ALGORITHM_WORKSTEALINGPOOL_H
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Pula wątków z podkradaniem zadań (work stealing) do wykonywania wielu niezależnych obliczeń
+// o różnej długości (w przeciwieństwie do ThreadPool, który dzieli statycznie jedną pętlę).
+// Zadania zlecone z zewnątrz trafiają do wspólnej kolejki FIFO, a zadania zlecone przez zadanie
+// wykonywane w puli (np. części dużego obliczenia) - do kolejki jego wątku. Wątek wykonuje najpierw
+// najnowsze zadanie z własnej kolejki, potem najstarsze ze wspólnej, a gdy obie są puste - podkrada
+// najstarsze zadanie z kolejki innego wątku. Zadania są długie (całe przebiegi algorytmu), więc
+// wszystkie kolejki chronione są jednym mutexem (bez kolejek bezblokadowych).
+class WorkStealingPool {
+public:
+    using Task = function<void(int worker)>;
+
+    explicit WorkStealingPool(int threadCount);
+
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int size() const {
+        return static_cast<int>(workers.size());
+    }
+
+    void submit(Task task);
+
+    // Oczekiwanie na wykonanie wszystkich zleconych zadań (tylko spoza wątków puli)
+    void wait();
+
+    // Liczba zadań podkradzionych z kolejek innych wątków
+    long long steals() const {
+        return stolenTasks.load(memory_order_relaxed);
+    }
+
+private:
+    // Kolejki zadań zleconych przez zadania wykonywane w poszczególnych wątkach
+    vector<deque<Task>> queues;
+    vector<thread> workers;
+
+    // Kolejka zadań zleconych spoza puli
+    deque<Task> injected;
+
+    mutex stateMutex;
+    condition_variable workAvailable;
+    condition_variable allDone;
+
+    // Zadania zlecone i niezakończone oraz zadania oczekujące w kolejkach
+    long long pendingTasks = 0;
+    long long queuedTasks = 0;
+    bool stopping = false;
+
+    atomic<long long> stolenTasks{0};
+
+    bool take(int worker, Task& task);
+
+    void workerLoop(int worker);
+};
+
+
+#endif //GENETIC_ALGORITHM_WORKSTEALINGPOOL_H
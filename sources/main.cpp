@@ -1,8 +1,14 @@
 #include "Interface.h"
+#include "CommandLine.h"
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
+
+    // Z argumentami program działa bez menu (tryb wsadowy), bez argumentów - interaktywnie
+    if (argc > 1) {
+        return CommandLine::run(argc, argv);
+    }
 
     Interface::menu();
 